@@ -0,0 +1,112 @@
+#include <algorithm>
+#include <cmath>
+#include <omp.h>
+#include <vector>
+
+#include "algorithms.hpp"
+#include "bandits.hpp"
+#include "benchmark/benchmark.h"
+
+using namespace std;
+using namespace bandits;
+
+// The solvers halt once they exceed `limit_pulls`, so limiting them to
+// the pulls of their first round benchmarks exactly one round.
+static const int NUM_ARMS = 1000;
+static const double EPSILON = 0.5;
+static const double DELTA = 0.1;
+
+static void BM_MedianEliminationRound(benchmark::State &state) {
+    // Set Up
+    auto bandit = make_bernoulli_bandit(NUM_ARMS, 0.1);
+
+    // Mirrors the first round in `MedianElimination::solve`.
+    double epsilon = EPSILON / 4;
+    double delta = DELTA / 2;
+    size_t num_pulls = ceil(1 / pow(epsilon / 2, 2) * log(3 / delta));
+    size_t round_pulls = NUM_ARMS * num_pulls;
+
+    MedianElimination algo(EPSILON, DELTA, round_pulls);
+
+    // Run
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(algo.solve(bandit));
+    }
+
+    state.SetItemsProcessed(state.iterations() * round_pulls);
+}
+BENCHMARK(BM_MedianEliminationRound)->Unit(benchmark::kMillisecond);
+
+static void BM_MultiRoundEpsilonArmRound(benchmark::State &state) {
+    // Set Up
+    auto num_players = static_cast<int>(state.range(0));
+    auto bandit = make_bernoulli_bandit(NUM_ARMS, 0.1);
+
+    // Mirrors the first round in `MultiRoundEpsilonArm::solve`.
+    double time = (2 / (num_players * pow(0.5, 2))) *
+        log((4 * NUM_ARMS) / DELTA);
+    size_t round_pulls = num_players * NUM_ARMS * ceil(time);
+
+    MultiRoundEpsilonArm algo(num_players, EPSILON, DELTA, round_pulls);
+
+    // Run
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(algo.solve(bandit));
+    }
+
+    state.SetItemsProcessed(state.iterations() * round_pulls);
+}
+BENCHMARK(BM_MultiRoundEpsilonArmRound)
+    ->RangeMultiplier(2)
+    ->Range(1, omp_get_num_procs())
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+// Whole solves of the sync and async solvers with up to 4x more players
+// than cores, to compare their (tail) latency under oversubscription.
+static const int SOLVE_NUM_ARMS = 1000;
+static const double SOLVE_MIN_GAP = 0.1;
+static const double SOLVE_EPSILON = 0.1;
+static const double SOLVE_DELTA = 0.05;
+
+template <typename Algorithm>
+static void BM_Solve(benchmark::State &state) {
+    // Set Up
+    auto num_players = static_cast<int>(state.range(0));
+    auto bandit = make_bernoulli_bandit(SOLVE_NUM_ARMS, SOLVE_MIN_GAP);
+    Algorithm algo(num_players, SOLVE_EPSILON, SOLVE_DELTA, (size_t) -1);
+    size_t total_pulls = 0;
+
+    // Run
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(algo.solve(bandit, total_pulls));
+    }
+
+    state.counters["pulls"] = benchmark::Counter(
+        total_pulls, benchmark::Counter::kAvgIterations);
+}
+
+static void SolveArgs(benchmark::internal::Benchmark *bench) {
+    for (int num_players = 1; num_players < 4 * omp_get_num_procs();
+         num_players *= 2) {
+        bench->Arg(num_players);
+    }
+    bench->Arg(4 * omp_get_num_procs());
+}
+
+BENCHMARK_TEMPLATE(BM_Solve, MultiRoundEpsilonArm)
+    ->Apply(SolveArgs)
+    ->Repetitions(5)
+    ->ComputeStatistics("max", [](const vector<double> &times) {
+        return *max_element(times.begin(), times.end());
+    })
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Solve, AsyncMultiRoundEpsilonArm)
+    ->Apply(SolveArgs)
+    ->Repetitions(5)
+    ->ComputeStatistics("max", [](const vector<double> &times) {
+        return *max_element(times.begin(), times.end());
+    })
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,37 @@
+#include <memory>
+#include <vector>
+
+#include "bandits.hpp"
+#include "benchmark/benchmark.h"
+
+using namespace std;
+using namespace bandits;
+
+static void BM_BernoulliArmPull(benchmark::State &state) {
+    // Set Up
+    BernoulliArm arm(0.5);
+
+    // Run
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(arm.pull());
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_BernoulliArmPull);
+
+static void BM_MakeBernoulliBandit(benchmark::State &state) {
+    // Set Up
+    auto num_arms = static_cast<int>(state.range(0));
+
+    // Run
+    for (auto _ : state) {
+        auto bandit = make_bernoulli_bandit(num_arms, 0.1);
+        benchmark::DoNotOptimize(bandit.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * num_arms);
+}
+BENCHMARK(BM_MakeBernoulliBandit)
+    ->Arg(1000000)
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,74 @@
+#!/usr/bin/env python3
+"""Compare Google Benchmark JSON results against a stored baseline.
+
+Exits with a non-zero status if the throughput of any benchmark dropped by
+more than the given percentage, or if a baseline benchmark is missing.
+Benchmarks without `items_per_second` are compared by their inverse real
+time. Repeated benchmarks are compared by their median and, if they report
+it, by their slowest repetition (the `max` statistic).
+"""
+import argparse
+import json
+import sys
+
+
+def load_throughputs(path):
+    with open(path) as f:
+        results = json.load(f)
+
+    throughputs = {}
+    for bench in results['benchmarks']:
+        if bench.get('run_type', 'iteration') == 'iteration':
+            if bench.get('repetitions', 1) > 1:
+                continue  # The repetitions share a name, use the aggregates.
+        elif bench.get('aggregate_name') == 'max':
+            # The slowest repetition, the throughput of the tail.
+            throughputs[bench['name']] = 1.0 / bench['real_time']
+            continue
+        elif bench.get('aggregate_name') != 'median':
+            continue  # Skip the mean and the dispersion aggregates.
+
+        if 'items_per_second' in bench:
+            throughputs[bench['name']] = bench['items_per_second']
+        else:
+            throughputs[bench['name']] = 1.0 / bench['real_time']
+
+    return throughputs
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument('baseline', help='Stored benchmarks JSON results.')
+    parser.add_argument('current', help='Current benchmarks JSON results.')
+    parser.add_argument('--max-regression', type=float, default=10.0,
+                        help='Max. allowed throughput drop in percent.')
+    args = parser.parse_args()
+
+    try:
+        baseline = load_throughputs(args.baseline)
+    except FileNotFoundError:
+        print(f'error: baseline {args.baseline} not found, '
+              'store one with `make bench_baseline`', file=sys.stderr)
+        return 2
+
+    current = load_throughputs(args.current)
+
+    failed = False
+    for name, base_value in sorted(baseline.items()):
+        if name not in current:
+            print(f'{name}: MISSING')
+            failed = True
+            continue
+
+        change = 100.0 * (current[name] - base_value) / base_value
+        status = 'OK'
+        if change < -args.max_regression:
+            status = 'REGRESSED'
+            failed = True
+        print(f'{name}: {change:+.1f}% {status}')
+
+    return 1 if failed else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,72 @@
+#include <atomic>
+#include <omp.h>
+
+#include "executor.hpp"
+#include "benchmark/benchmark.h"
+
+using namespace std;
+using namespace bandits;
+
+// The dispatch latency of a solver round with tiny players, the shared
+// executor versus an OpenMP team of the same size.
+static void BM_ExecutorParallelFor(benchmark::State &state) {
+    // Set Up
+    auto num_tasks = static_cast<size_t>(state.range(0));
+    auto &executor = Executor::get_shared();
+    atomic<size_t> num_runs(0);
+
+    // Run
+    for (auto _ : state) {
+        executor.parallel_for(num_tasks, [&](size_t) {
+            num_runs.fetch_add(1, memory_order_relaxed);
+        });
+    }
+
+    state.SetItemsProcessed(num_runs.load());
+}
+BENCHMARK(BM_ExecutorParallelFor)
+    ->RangeMultiplier(4)
+    ->Range(1, 64)
+    ->Unit(benchmark::kMicrosecond);
+
+// Same with worker threads whatever the cores, so the queue and the wake up
+// paths are measured, not the inline one of a one-core host.
+static void BM_ExecutorWithWorkersParallelFor(benchmark::State &state) {
+    // Set Up
+    auto num_workers = static_cast<int>(state.range(0));
+    auto num_tasks = static_cast<size_t>(state.range(1));
+    auto options = default_executor_options();
+    options.num_workers = num_workers;
+    Executor executor(options);
+    atomic<size_t> num_runs(0);
+
+    // Run
+    for (auto _ : state) {
+        executor.parallel_for(num_tasks, [&](size_t) {
+            num_runs.fetch_add(1, memory_order_relaxed);
+        });
+    }
+
+    state.SetItemsProcessed(num_runs.load());
+}
+BENCHMARK(BM_ExecutorWithWorkersParallelFor)
+    ->ArgsProduct({{1, 3, 7}, {4, 16, 64}})
+    ->Unit(benchmark::kMicrosecond);
+
+static void BM_OpenMPParallelRegion(benchmark::State &state) {
+    // Set Up
+    auto num_threads = static_cast<int>(state.range(0));
+    atomic<size_t> num_runs(0);
+
+    // Run
+    for (auto _ : state) {
+        #pragma omp parallel num_threads(num_threads)
+        num_runs.fetch_add(1, memory_order_relaxed);
+    }
+
+    state.SetItemsProcessed(num_runs.load());
+}
+BENCHMARK(BM_OpenMPParallelRegion)
+    ->RangeMultiplier(4)
+    ->Range(1, 64)
+    ->Unit(benchmark::kMicrosecond);
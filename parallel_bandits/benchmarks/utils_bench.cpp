@@ -0,0 +1,31 @@
+#include <random>
+#include <vector>
+
+#include "utils.hpp"
+#include "benchmark/benchmark.h"
+
+using namespace std;
+using namespace bandits;
+
+static void BM_MedianHeapPush(benchmark::State &state) {
+    // Set Up
+    auto num_values = static_cast<size_t>(state.range(0));
+    default_random_engine rnd_gen;
+    uniform_real_distribution<double> distribution(0, 1);
+    vector<MedianHeap::value_type> values;
+    for (size_t i = 0; i < num_values; i++) {
+        values.push_back(make_pair(distribution(rnd_gen), i));
+    }
+
+    // Run
+    for (auto _ : state) {
+        MedianHeap median_heap;
+        for (auto &value : values) {
+            median_heap.push(value);
+        }
+        benchmark::DoNotOptimize(median_heap.get_upper_half().data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * num_values);
+}
+BENCHMARK(BM_MedianHeapPush)->Arg(1 << 10)->Arg(1 << 16);
@@ -0,0 +1,45 @@
+#include <fstream>
+#include <iostream>
+
+#include "results.hpp"
+
+using namespace std;
+using namespace bandits;
+
+int main(int argc, char **argv) {
+    if (argc != 3) {
+        cerr << "Usage: " << argv[0] << " <results.bin> <results.csv>" << endl;
+        return 1;
+    }
+
+    ResultsReader reader(argv[1]);
+    if (!reader.is_valid()) {
+        cerr << "Not a results file: " << argv[1] << endl;
+        return 1;
+    }
+
+    // The same layout as the notebooks in `etc/jnotebooks` read.
+    ofstream csv(argv[2], fstream::out);
+    auto &columns = get_result_columns();
+    for (size_t i = 0; i < columns.size(); i++) {
+        csv << (i > 0 ? "," : "") << columns[i];
+    }
+    csv << "\n";
+
+    ResultRecord record;
+    size_t num_records = 0;
+    while (reader.next(record)) {
+        csv << record.num_arms << ","
+            << record.min_gap << ","
+            << record.num_threads << ","
+            << record.epsilon << ","
+            << record.delta << ","
+            << record.elapsed << ","
+            << record.pulls << ","
+            << (int) record.solved << "\n";
+        num_records++;
+    }
+
+    cout << "Exported " << num_records << " records to " << argv[2] << endl;
+    return 0;
+}
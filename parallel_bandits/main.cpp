@@ -1,11 +1,12 @@
 #include <cstdlib>
 #include <chrono>
 #include <iostream>
-#include <fstream>
 #include <omp.h>
+#include <string>
 
 #include "algorithms.hpp"
 #include "bandits.hpp"
+#include "results.hpp"
 
 using namespace std;
 using namespace bandits;
@@ -18,10 +19,11 @@ struct Result {
 };
 
 Result measure_expgap(int num_arms, double min_gap,
-                      double epsilon, double delta)
+                      double epsilon, double delta,
+                      Bound bound = Bound::Hoeffding)
 {
     auto bandit = make_bernoulli_bandit(num_arms, min_gap);
-    ExpGapElimination expgap_algo(epsilon, delta, (size_t) -1);
+    ExpGapElimination expgap_algo(epsilon, delta, (size_t) -1, bound);
     size_t total_pulls = 0;
 
     auto begin = steady_clock::now();
@@ -38,11 +40,12 @@ Result measure_expgap(int num_arms, double min_gap,
 }
 
 Result measure_multiround(int num_arms, double min_gap, int num_threads,
-                          double epsilon, double delta)
+                          double epsilon, double delta,
+                          Bound bound = Bound::Hoeffding)
 {
     auto bandit = make_bernoulli_bandit(num_arms, min_gap);
     MultiRoundEpsilonArm multiround_algo(num_threads, epsilon, delta,
-                                         (size_t) -1);
+                                         (size_t) -1, bound);
     size_t total_pulls = 0;
 
     auto begin = steady_clock::now();
@@ -58,6 +61,67 @@ Result measure_multiround(int num_arms, double min_gap, int num_threads,
     return result;
 }
 
+Result measure_async_multiround(int num_arms, double min_gap, int num_threads,
+                                double epsilon, double delta)
+{
+    auto bandit = make_bernoulli_bandit(num_arms, min_gap);
+    AsyncMultiRoundEpsilonArm multiround_algo(num_threads, epsilon, delta,
+                                              (size_t) -1);
+    size_t total_pulls = 0;
+
+    auto begin = steady_clock::now();
+    auto solution_arm = multiround_algo.solve(bandit, total_pulls);
+    auto end = steady_clock::now();
+
+    Result result = {
+        duration_cast<milliseconds>(end - begin),
+        total_pulls,
+        solution_arm == (num_arms - 1)
+    };
+
+    return result;
+}
+
+ResultRecord make_record(int num_arms, double min_gap, int num_threads,
+                         double epsilon, double delta, const Result &result)
+{
+    ResultRecord record = {
+        (uint64_t) num_arms,
+        min_gap,
+        (uint32_t) num_threads,
+        epsilon,
+        delta,
+        result.elapsed.count(),
+        result.total_pulls,
+        result.is_solved
+    };
+
+    return record;
+}
+
+// Pulls and time of the Hoeffding runs and their Bernstein counterparts.
+struct Savings {
+    double hoeffding_pulls = 0, bernstein_pulls = 0;
+    double hoeffding_time = 0, bernstein_time = 0;
+
+    void add(const Result &hoeffding, const Result &bernstein)
+    {
+        this->hoeffding_pulls += hoeffding.total_pulls;
+        this->bernstein_pulls += bernstein.total_pulls;
+        this->hoeffding_time += hoeffding.elapsed.count();
+        this->bernstein_time += bernstein.elapsed.count();
+    }
+
+    void print(const string &name) const
+    {
+        cout << name << " empirical Bernstein saves "
+             << 100 * (1 - this->bernstein_pulls / this->hoeffding_pulls)
+             << "% pulls, "
+             << 100 * (1 - this->bernstein_time / this->hoeffding_time)
+             << "% time over Hoeffding." << endl;
+    }
+};
+
 int main(int argc, char **argv) {
     // Seed the random generator.
     srand(static_cast<unsigned int>(time(NULL)));
@@ -86,15 +150,20 @@ int main(int argc, char **argv) {
                              delta_params.size());
     int run_count = 0;
 
-    ofstream expgap_results;
-    expgap_results.open("expgap_results.csv", fstream::out);
-    expgap_results << "num_arms,min_gap,num_threads,epsilon,delta"
-                   << ",elapsed,pulls,solved" << endl;
-
-    ofstream multiround_results;
-    multiround_results.open("multiround_results.csv", fstream::out);
-    multiround_results << "num_arms,min_gap,num_threads,epsilon,delta"
-                       << ",elapsed,pulls,solved" << endl;
+    // Written in the background, export them with `run_export` to CSV.
+    // Each sweep starts the files over, so sweeps don't get mixed.
+    const auto mode = WriteMode::Truncate;
+    ResultsWriter expgap_results("expgap_results.bin", mode);
+    ResultsWriter multiround_results("multiround_results.bin", mode);
+    // Same layout as the synchronous results to compare the (tail) latency.
+    ResultsWriter async_multiround_results("async_multiround_results.bin",
+                                           mode);
+    // Variance-adaptive bounds, compared with the Hoeffding ones at the end.
+    ResultsWriter expgap_bernstein_results("expgap_bernstein_results.bin",
+                                           mode);
+    ResultsWriter multiround_bernstein_results(
+        "multiround_bernstein_results.bin", mode);
+    Savings expgap_savings, multiround_savings;
 
     auto begin = steady_clock::now();
     for (auto &num_arms : num_arms_params) {
@@ -102,31 +171,39 @@ int main(int argc, char **argv) {
     for (auto &epsilon : epsilon_params) {
     for (auto &delta : delta_params) {
         auto result = measure_expgap(num_arms, min_gap, epsilon, delta);
-        expgap_results << num_arms << ","
-                       << min_gap << ","
-                       << 1 << "," // Num. threads
-                       << epsilon << ","
-                       << delta << ","
-                       << result.elapsed.count() << ","
-                       << result.total_pulls << ","
-                       << result.is_solved << endl;
+        expgap_results.write(make_record(num_arms, min_gap, 1, // Num. threads
+                                         epsilon, delta, result));
+
+        auto bernstein_result = measure_expgap(num_arms, min_gap, epsilon,
+                                               delta,
+                                               Bound::EmpiricalBernstein);
+        expgap_bernstein_results.write(make_record(num_arms, min_gap, 1,
+                                                   epsilon, delta,
+                                                   bernstein_result));
+        expgap_savings.add(result, bernstein_result);
 
         for (auto &num_threads : num_threads_params) {
             auto result = measure_multiround(num_arms, min_gap, num_threads,
                                              epsilon, delta);
-            multiround_results << num_arms << ","
-                               << min_gap << ","
-                               << num_threads << ","
-                               << epsilon << ","
-                               << delta << ","
-                               << result.elapsed.count() << ","
-                               << result.total_pulls << ","
-                               << result.is_solved << endl;
+            multiround_results.write(make_record(num_arms, min_gap,
+                                                 num_threads, epsilon, delta,
+                                                 result));
+
+            auto bernstein_result = measure_multiround(
+                num_arms, min_gap, num_threads, epsilon, delta,
+                Bound::EmpiricalBernstein);
+            multiround_bernstein_results.write(make_record(
+                num_arms, min_gap, num_threads, epsilon, delta,
+                bernstein_result));
+            multiround_savings.add(result, bernstein_result);
+
+            auto async_result = measure_async_multiround(
+                num_arms, min_gap, num_threads, epsilon, delta);
+            async_multiround_results.write(make_record(num_arms, min_gap,
+                                                       num_threads, epsilon,
+                                                       delta, async_result));
         }
 
-        expgap_results.flush();
-        multiround_results.flush();
-
         auto total_time = duration_cast<seconds>(steady_clock::now() - begin);
         run_count++;
         cout << "Elapsed: " << total_time.count() << "s | "
@@ -135,5 +212,11 @@ int main(int argc, char **argv) {
     
     expgap_results.close();
     multiround_results.close();
+    async_multiround_results.close();
+    expgap_bernstein_results.close();
+    multiround_bernstein_results.close();
+
+    expgap_savings.print("ExpGap");
+    multiround_savings.print("MultiRound");
     return 0;
 }
@@ -1,17 +1,217 @@
 #include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <cstdint>
 #include <cstdlib>
+#include <functional>
+#include <limits>
 #include <memory>
-#include <omp.h>
+#include <numeric>
 #include <random>
 #include <vector>
 
 #include "algorithms.hpp"
+#include "checkpoint.hpp"
+#include "executor.hpp"
 #include "utils.hpp"
 
 using namespace std;
 using namespace bandits;
 
+/**
+ * Take the `k` highest values and return their indexes, the best first.
+ *
+ * Only the selected `k` values get sorted, the rest is partially selected.
+ */
+static vector<size_t>
+take_top(vector<MedianHeap::value_type> &values, size_t k)
+{
+    select_top(values, k);
+    values.resize(min(k, values.size()));
+    sort(values.begin(), values.end(), greater<MedianHeap::value_type>());
+
+    vector<size_t> top_idxs;
+    for (auto &value_arm_pair : values) {
+        top_idxs.push_back(value_arm_pair.second);
+    }
+
+    return top_idxs;
+}
+
+/**
+ * Run `run_chunk(begin, end)` over [0, num_items) in chunks of `chunk_size`.
+ *
+ * Inside a task of the executor, e.g. a player's, the chunks are tasks too,
+ * so idle workers can help. Otherwise, it runs serially.
+ */
+static void
+for_each_chunk(size_t num_items, size_t chunk_size,
+               const function<void(size_t, size_t)> &run_chunk)
+{
+    if (!Executor::is_in_task()) {
+        run_chunk(0, num_items);
+        return;
+    }
+
+    chunk_size = max<size_t>(chunk_size, 1);
+    auto num_chunks = (num_items + chunk_size - 1) / chunk_size;
+    Executor::get_shared().parallel_for(num_chunks, [&](size_t c) {
+        run_chunk(c * chunk_size, min((c + 1) * chunk_size, num_items));
+    });
+}
+
+/**
+ * Pull each arm `num_pulls` times and return the average returns.
+ */
+static vector<double>
+evaluate_arms(const vector<shared_ptr<IBanditArm>> &bandit,
+              const vector<size_t> &arm_idxs, int num_pulls)
+{
+    // Make tasks big enough to amortize their overhead.
+    const long min_task_pulls = 1 << 16;
+    vector<double> average_returns(arm_idxs.size());
+
+    for_each_chunk(arm_idxs.size(), min_task_pulls / max(num_pulls, 1),
+                   [&](size_t begin, size_t end) {
+        for (auto i = begin; i < end; i++) {
+            auto &arm = bandit[arm_idxs[i]];
+            double total_return = 0;
+            for (int j = 0; j < num_pulls; j++) {
+                total_return += arm->pull();
+            }
+            average_returns[i] = total_return / num_pulls;
+        }
+    });
+
+    return average_returns;
+}
+
+/**
+ * Two-sided Hoeffding radius of the mean of `num_pulls` rewards in [0, 1].
+ */
+static double
+hoeffding_radius(double num_pulls, double delta)
+{
+    return sqrt(log(2 / delta) / (2 * num_pulls));
+}
+
+/**
+ * Two-sided empirical Bernstein radius of the mean of `num_pulls` rewards
+ * in [0, 1] with the sample `variance`.
+ *
+ * See: Maurer, A., and Pontil, M., “Empirical Bernstein Bounds and
+ *      Sample Variance Penalization”, 2009.
+ */
+static double
+bernstein_radius(double num_pulls, double variance, double delta)
+{
+    if (num_pulls < 2) {
+        return numeric_limits<double>::infinity();
+    }
+
+    auto log_term = log(4 / delta);
+    return sqrt(2 * variance * log_term / num_pulls) +
+        7 * log_term / (3 * (num_pulls - 1));
+}
+
+static double
+sample_variance(double sum, double sum_squares, double num_pulls)
+{
+    if (num_pulls < 2) {
+        return 0.25; // The max. variance of rewards in [0, 1].
+    }
+
+    return max(0.0, (sum_squares - sum * sum / num_pulls) / (num_pulls - 1));
+}
+
+/**
+ * Pull each arm in doubling batches, until the empirical Bernstein radius
+ * is at most ε/2 or the arm was pulled `max_pulls` times, and return the
+ * average returns.
+ *
+ * @param[in] bandit Vector of bandit arms to pull.
+ * @param[in] arm_idxs Indexes of the arms to evaluate.
+ * @param[in] max_pulls Limit of pulls per arm.
+ * @param[in] epsilon Required accuracy of the average returns times two.
+ * @param[in] delta Probability of any of the batch checks failing per arm.
+ * @param[out] num_pulls Total number of pulls made.
+ * @param[out] num_unresolved Number of arms which reached `max_pulls`
+ *     before the radius.
+ */
+static vector<double>
+evaluate_arms_bernstein(const vector<shared_ptr<IBanditArm>> &bandit,
+                        const vector<size_t> &arm_idxs, long max_pulls,
+                        double epsilon, double delta, size_t &num_pulls,
+                        size_t &num_unresolved)
+{
+    const long min_pulls = 32;
+    const long min_task_pulls = 1 << 16;
+    auto num_checks = max(1.0, ceil(log2((double) max_pulls / min_pulls)) + 1);
+    auto check_delta = delta / num_checks;
+    vector<double> average_returns(arm_idxs.size());
+    vector<long> arms_pulls(arm_idxs.size());
+    vector<char> is_resolved(arm_idxs.size(), false);
+
+    for_each_chunk(arm_idxs.size(), min_task_pulls / max(max_pulls, 1L),
+                   [&](size_t begin, size_t end) {
+        for (auto i = begin; i < end; i++) {
+            auto &arm = bandit[arm_idxs[i]];
+            double total_return = 0, total_squares = 0;
+            long arm_pulls = 0;
+            while (arm_pulls < max_pulls) {
+                auto batch_end = min(max_pulls,
+                                     max(min_pulls, 2 * arm_pulls));
+                for (; arm_pulls < batch_end; arm_pulls++) {
+                    auto reward = arm->pull();
+                    total_return += reward;
+                    total_squares += reward * reward;
+                }
+
+                auto variance = sample_variance(total_return, total_squares,
+                                                arm_pulls);
+                if (bernstein_radius(arm_pulls, variance, check_delta) <=
+                    epsilon / 2) {
+                    is_resolved[i] = true;
+                    break;
+                }
+            }
+            average_returns[i] = total_return / arm_pulls;
+            arms_pulls[i] = arm_pulls;
+        }
+    });
+
+    num_pulls = accumulate(arms_pulls.begin(), arms_pulls.end(), 0L);
+    num_unresolved = count(is_resolved.begin(), is_resolved.end(), false);
+    return average_returns;
+}
+
+/**
+ * Evaluate the arms for a round of the median elimination.
+ *
+ * With the Hoeffding bound, each arm is pulled `num_pulls` times. With the
+ * empirical Bernstein bound, an arm stops as soon as it's known within ε/2.
+ * The Hoeffding count fails with at most 2(δ/3)^2 <= δ/6 per arm (for
+ * δ <= 3/4), which leaves δ/6 of the arm's δ/3 for the Bernstein checks,
+ * so it never needs more pulls.
+ *
+ * @param[out] num_made Total number of pulls made.
+ */
+static vector<double>
+evaluate_median_round(const vector<shared_ptr<IBanditArm>> &bandit,
+                      const vector<size_t> &arm_idxs, int num_pulls,
+                      double epsilon, double delta, Bound bound,
+                      size_t &num_made)
+{
+    if (bound == Bound::Hoeffding) {
+        num_made = arm_idxs.size() * num_pulls;
+        return evaluate_arms(bandit, arm_idxs, num_pulls);
+    }
+
+    size_t num_unresolved;
+    return evaluate_arms_bernstein(bandit, arm_idxs, num_pulls, epsilon,
+                                   delta / 6, num_made, num_unresolved);
+}
+
 size_t
 MedianElimination::solve(const vector<shared_ptr<IBanditArm>> &bandit,
                          size_t &total_pulls) const
@@ -36,14 +236,15 @@ MedianElimination::solve(const vector<shared_ptr<IBanditArm>> &bandit,
             return current_arms[0];
         }
 
-        // Evaluate each arm.
-        for (auto &idx : current_arms) {
-            auto &arm = bandit[idx];
-            double total_return = 0;
-            for (int i = 0; i < num_pulls; i++) {
-                total_return += arm->pull();
-            }
-            empirical_values.push(make_pair(total_return / num_pulls, idx));
+        // Evaluate each arm, only the pulls made are counted.
+        size_t round_pulls;
+        auto average_returns = evaluate_median_round(
+            bandit, current_arms, num_pulls, epsilon, delta, this->_bound,
+            round_pulls);
+        total_pulls -= current_arms.size() * num_pulls - round_pulls;
+        for (size_t i = 0; i < current_arms.size(); i++) {
+            empirical_values.push(make_pair(average_returns[i],
+                                            current_arms[i]));
         }
 
         // Pick arms above the median empirical value.
@@ -61,6 +262,97 @@ MedianElimination::solve(const vector<shared_ptr<IBanditArm>> &bandit,
     return current_arms[0];
 }
 
+vector<size_t>
+MedianElimination::solve_topk(const vector<shared_ptr<IBanditArm>> &bandit,
+                              size_t k, size_t &total_pulls) const
+{
+    double epsilon = this->_epsilon / 4;
+    double delta = this->_delta / 2;
+    vector<MedianHeap::value_type> empirical_values;
+
+    if (k == 0) {
+        return vector<size_t>();
+    }
+
+    // Initialize current arms indexes to [0, arms.size()).
+    vector<size_t> current_arms(bandit.size());
+    iota(current_arms.begin(), current_arms.end(), 0);
+
+    while (current_arms.size() > k) {
+        int num_pulls = ceil(1 / pow(epsilon / 2, 2) * log(3 / delta));
+
+        total_pulls += current_arms.size() * num_pulls;
+        if (total_pulls > this->_limit_pulls) {
+            // Halt and return arbitrary arms;
+            current_arms.resize(k);
+            return current_arms;
+        }
+
+        // Evaluate each arm, only the pulls made are counted.
+        size_t round_pulls;
+        auto average_returns = evaluate_median_round(
+            bandit, current_arms, num_pulls, epsilon, delta, this->_bound,
+            round_pulls);
+        total_pulls -= current_arms.size() * num_pulls - round_pulls;
+        empirical_values.clear();
+        for (size_t i = 0; i < current_arms.size(); i++) {
+            empirical_values.push_back(make_pair(average_returns[i],
+                                                 current_arms[i]));
+        }
+
+        // Pick arms above the median empirical value, but no less than k.
+        auto num_subset_arms = max(k, (current_arms.size() + 1) / 2);
+        select_top(empirical_values, num_subset_arms);
+        empirical_values.resize(num_subset_arms);
+
+        vector<size_t> subset_arms;
+        for (auto &value_arm_pair : empirical_values) {
+            subset_arms.push_back(value_arm_pair.second);
+        }
+
+        // Bookkeeping.
+        epsilon = 0.75 * epsilon;
+        delta = delta / 2.0;
+        swap(current_arms, subset_arms);
+    }
+
+    if (empirical_values.empty()) {
+        // No arm was pulled, there is k arms or less.
+        return current_arms;
+    }
+
+    return take_top(empirical_values, k);
+}
+
+vector<double>
+ExpGapElimination::evaluate_round(
+    const vector<shared_ptr<IBanditArm>> &bandit,
+    const vector<size_t> &arm_idxs, int num_pulls, double epsilon,
+    double delta, size_t &total_pulls, bool &is_halted) const
+{
+    is_halted = false;
+    if (this->_bound == Bound::Hoeffding) {
+        return evaluate_arms(bandit, arm_idxs, num_pulls);
+    }
+
+    // The Hoeffding fallback gets half the delta, but no more pulls than
+    // the limit leaves. Only the pulls made are counted.
+    total_pulls -= arm_idxs.size() * num_pulls;
+    size_t fallback_pulls = ceil(2 / pow(epsilon, 2) * log(4 / delta));
+    auto max_pulls = min(fallback_pulls,
+                         (this->_limit_pulls - total_pulls) / arm_idxs.size());
+
+    size_t round_pulls, num_unresolved;
+    auto average_returns = evaluate_arms_bernstein(
+        bandit, arm_idxs, max_pulls, epsilon, delta / 2, round_pulls,
+        num_unresolved);
+    total_pulls += round_pulls;
+
+    // An arm cut short by the limit isn't known within ε/2.
+    is_halted = max_pulls < fallback_pulls && num_unresolved > 0;
+    return average_returns;
+}
+
 size_t
 ExpGapElimination::solve(const vector<shared_ptr<IBanditArm>> &bandit,
                          size_t &total_pulls) const
@@ -80,7 +372,6 @@ ExpGapElimination::solve(const vector<shared_ptr<IBanditArm>> &bandit,
         double epsilon = pow(2, -round) / 4;
         double delta = this->_delta / (50.0 * pow(round, 3));
 
-        vector<double> empirical_values;
         int num_pulls = ceil(2 / pow(epsilon, 2) * log(2 / delta));
 
         total_pulls += current_arms.size() * num_pulls;
@@ -90,17 +381,18 @@ ExpGapElimination::solve(const vector<shared_ptr<IBanditArm>> &bandit,
         }
 
         // Evaluate each arm.
-        for (auto &arm : current_arms) {
-            double total_return = 0;
-            for (int i = 0; i < num_pulls; i++) {
-                total_return += arm->pull();
-            }
-            empirical_values.push_back(total_return / num_pulls);
+        bool is_halted;
+        auto empirical_values = this->evaluate_round(
+            bandit, current_idxs, num_pulls, epsilon, delta, total_pulls,
+            is_halted);
+        if (is_halted) {
+            return current_idxs[0];
         }
 
         // Find (epsilon_r, delta_r)-optimal arm.
         // TODO(pj): Use pulls (empirical values) from the above eval.
-        MedianElimination med_elim_algo(epsilon / 2, delta, this->_limit_pulls);
+        MedianElimination med_elim_algo(epsilon / 2, delta, this->_limit_pulls,
+                                        this->_bound);
         auto best_arm_idx = med_elim_algo.solve(current_arms, total_pulls);
         auto best_value = empirical_values[best_arm_idx];
 
@@ -123,30 +415,205 @@ ExpGapElimination::solve(const vector<shared_ptr<IBanditArm>> &bandit,
     return current_idxs[0];
 }
 
+vector<size_t>
+ExpGapElimination::solve_topk(const vector<shared_ptr<IBanditArm>> &bandit,
+                              size_t k, size_t &total_pulls) const
+{
+    int round = 1;
+    vector<shared_ptr<IBanditArm>> current_arms;
+    vector<size_t> current_idxs;
+    vector<double> current_values;
+
+    if (k == 0) {
+        return vector<size_t>();
+    }
+
+    // Initialize current arms.
+    for (size_t i = 0; i < bandit.size(); i++) {
+        current_arms.push_back(bandit[i]);
+        current_idxs.push_back(i);
+    }
+
+    while (current_arms.size() > k &&
+           (this->_epsilon == 0 || round < ceil(log2(1 / this->_epsilon)))) {
+        double epsilon = pow(2, -round) / 4;
+        double delta = this->_delta / (50.0 * pow(round, 3));
+
+        int num_pulls = ceil(2 / pow(epsilon, 2) * log(2 / delta));
+
+        total_pulls += current_arms.size() * num_pulls;
+        if (total_pulls > this->_limit_pulls) {
+            // Halt and return the best looking arms, if any were pulled;
+            break;
+        }
+
+        // Evaluate each arm.
+        bool is_halted;
+        auto empirical_values = this->evaluate_round(
+            bandit, current_idxs, num_pulls, epsilon, delta, total_pulls,
+            is_halted);
+        if (is_halted) {
+            break;
+        }
+
+        // Find (epsilon_r, delta_r)-optimal k arms.
+        MedianElimination med_elim_algo(epsilon / 2, delta, this->_limit_pulls,
+                                        this->_bound);
+        auto top_arms_idxs =
+            med_elim_algo.solve_topk(current_arms, k, total_pulls);
+        auto kth_value = empirical_values[top_arms_idxs[0]];
+        for (auto &arm_idx : top_arms_idxs) {
+            kth_value = min(kth_value, empirical_values[arm_idx]);
+        }
+
+        // Pick arms above the epsilon-kth value.
+        vector<shared_ptr<IBanditArm>> subset_arms;
+        vector<size_t> subset_idxs;
+        vector<double> subset_values;
+        for (size_t i = 0; i < empirical_values.size(); i++) {
+            if (empirical_values[i] >= kth_value - epsilon) {
+                subset_arms.push_back(current_arms[i]);
+                subset_idxs.push_back(current_idxs[i]);
+                subset_values.push_back(empirical_values[i]);
+            }
+        }
+
+        // Bookkeeping.
+        round += 1;
+        swap(current_arms, subset_arms);
+        swap(current_idxs, subset_idxs);
+        swap(current_values, subset_values);
+    }
+
+    if (current_values.empty()) {
+        // No arm was pulled, return arbitrary arms.
+        current_idxs.resize(min(k, current_idxs.size()));
+        return current_idxs;
+    }
+
+    // Pick the top k arms from the survivors.
+    vector<MedianHeap::value_type> survivors;
+    for (size_t i = 0; i < current_values.size(); i++) {
+        survivors.push_back(make_pair(current_values[i], current_idxs[i]));
+    }
+
+    return take_top(survivors, k);
+}
+
+/**
+ * Pull the arm `num_pulls` times and return the total return.
+ */
+static double
+pull_arm(const IBanditArm &arm, size_t num_pulls)
+{
+    const size_t chunk_pulls = 1 << 16;
+    auto num_chunks = (num_pulls + chunk_pulls - 1) / chunk_pulls;
+    vector<double> chunk_returns(num_chunks, 0);
+
+    for_each_chunk(num_chunks, 1, [&](size_t begin, size_t end) {
+        for (auto c = begin; c < end; c++) {
+            auto chunk_end = min((c + 1) * chunk_pulls, num_pulls);
+            double total_return = 0;
+            for (auto i = c * chunk_pulls; i < chunk_end; i++) {
+                total_return += arm.pull();
+            }
+            chunk_returns[c] = total_return;
+        }
+    });
+
+    return accumulate(chunk_returns.begin(), chunk_returns.end(), 0.0);
+}
+
+/**
+ * Choose a player's subset of arms uniformly at random.
+ */
+static vector<size_t>
+choose_sub_idxs(size_t num_arms, int num_players)
+{
+    default_random_engine rnd_gen;
+    vector<size_t> all_idxs(num_arms);
+    iota(all_idxs.begin(), all_idxs.end(), 0);
+    shuffle(all_idxs.begin(), all_idxs.end(), rnd_gen);
+
+    size_t num_sub_arms =
+        min<size_t>(ceil(6.0 * num_arms / sqrt(num_players)), num_arms);
+    all_idxs.resize(num_sub_arms);
+
+    return all_idxs;
+}
+
+/**
+ * Votes of the players for one arm.
+ */
+struct ArmVotes {
+    double value;
+    size_t arm_idx;
+    size_t count;
+};
+
+/**
+ * Sort the (value, arm idx) votes by arm and return where each arm's run
+ * of votes begins, plus the end of the last run.
+ */
+static vector<size_t>
+sort_votes(vector<pair<double, size_t>> &votes)
+{
+    sort(votes.begin(), votes.end(),
+         [](const pair<double, size_t> &a, const pair<double, size_t> &b) {
+             return a.second < b.second;
+         });
+
+    vector<size_t> run_begins;
+    for (size_t i = 0; i < votes.size(); i++) {
+        if (i == 0 || votes[i].second != votes[i - 1].second) {
+            run_begins.push_back(i);
+        }
+    }
+    run_begins.push_back(votes.size());
+
+    return run_begins;
+}
+
+static ArmVotes
+count_votes(const vector<pair<double, size_t>> &votes,
+            size_t run_begin, size_t run_end)
+{
+    ArmVotes arm_votes = {0, votes[run_begin].second, run_end - run_begin};
+    for (size_t i = run_begin; i < run_end; i++) {
+        arm_votes.value += votes[i].first;
+    }
+    arm_votes.value /= arm_votes.count;
+
+    return arm_votes;
+}
+
 size_t
 OneRoundBestArm::solve(const vector<shared_ptr<IBanditArm>> &bandit,
                        size_t &total_pulls) const
 {
+    return this->solve_topk(bandit, 1, total_pulls)[0];
+}
 
-    vector<pair<double, size_t>> empirical_values(this->_num_players);
-    #pragma omp parallel \
-        num_threads(this->_num_players) \
-        shared(bandit, total_pulls, empirical_values)
-    {
-        auto num_pulls = this->_time_horizon / 2;
+vector<size_t>
+OneRoundBestArm::solve_topk(const vector<shared_ptr<IBanditArm>> &bandit,
+                            size_t k, size_t &total_pulls) const
+{
+    if (k == 0 || bandit.empty()) {
+        return vector<size_t>();
+    }
 
-        // Choose a subset of arms uniformly at random.
-        default_random_engine rnd_gen;
-        vector<size_t> all_idxs(bandit.size());
-        iota(all_idxs.begin(), all_idxs.end(), 0);
-        shuffle(all_idxs.begin(), all_idxs.end(), rnd_gen);
+    auto &executor = Executor::get_shared();
+    vector<vector<pair<double, size_t>>>
+        empirical_values(this->_num_players);
+    vector<size_t> players_pulls(this->_num_players, 0);
 
-        size_t num_sub_arms =
-            min<size_t>(ceil(6.0 * bandit.size() / sqrt(this->_num_players)),
-                        bandit.size());
-        vector<size_t> sub_idxs(all_idxs.begin(),
-                                all_idxs.begin() + num_sub_arms);
+    // Players are tasks of the shared executor. The workers left without
+    // a player help the others with their arm evaluations.
+    executor.parallel_for(this->_num_players, [&](size_t my_idx) {
+        auto num_pulls = this->_time_horizon / 2;
 
+        // Choose a subset of arms uniformly at random.
+        auto sub_idxs = choose_sub_idxs(bandit.size(), this->_num_players);
         vector<shared_ptr<IBanditArm>> sub_arms;
         for (auto &idx : sub_idxs) {
             sub_arms.push_back(bandit[idx]);
@@ -156,122 +623,726 @@ OneRoundBestArm::solve(const vector<shared_ptr<IBanditArm>> &bandit,
         size_t _total_pulls = 0;
         ExpGapElimination expgap_algo(0, 1.0 / 3.0, num_pulls);
 
-        auto solution_idx = expgap_algo.solve(sub_arms, _total_pulls);
-        auto best_arm_idx = sub_idxs[solution_idx];
-        auto best_arm = sub_arms[solution_idx];
+        auto solution_idxs =
+            expgap_algo.solve_topk(sub_arms, k, _total_pulls);
 
-        #pragma omp atomic
-        total_pulls += _total_pulls;
+        // Exploit, split the pulls evenly between the top arms.
+        size_t num_arm_pulls =
+            max<size_t>(num_pulls / solution_idxs.size(), 1);
+        for (auto &solution_idx : solution_idxs) {
+            auto total_return = pull_arm(*sub_arms[solution_idx],
+                                         num_arm_pulls);
 
-        // Exploit
-        double total_return = 0;
-        for (size_t i = 0; i < num_pulls; i++) {
-            total_return += best_arm->pull();
+            // Communicate the top arm idx and value.
+            auto average_return = total_return / num_arm_pulls;
+            empirical_values[my_idx].push_back(
+                make_pair(average_return, sub_idxs[solution_idx]));
         }
 
-        #pragma omp atomic
-        total_pulls += num_pulls;
+        players_pulls[my_idx] =
+            _total_pulls + solution_idxs.size() * num_arm_pulls;
+    });
+    total_pulls += accumulate(players_pulls.begin(), players_pulls.end(),
+                              (size_t) 0);
 
-        // Communicate the best arm idx and value.
-        auto my_idx = omp_get_thread_num();
-        empirical_values[my_idx] =
-            make_pair(total_return / num_pulls, best_arm_idx);
+    // Aggregate the votes per arm in parallel.
+    vector<pair<double, size_t>> votes;
+    for (auto &player_values : empirical_values) {
+        votes.insert(votes.end(), player_values.begin(), player_values.end());
     }
+    auto run_begins = sort_votes(votes);
+    vector<ArmVotes> arms_votes(run_begins.size() - 1);
+    auto num_chunks = min<size_t>(executor.get_concurrency(),
+                                  arms_votes.size());
 
-    vector<double> arms_total(bandit.size(), 0);
-    vector<size_t> arms_count(bandit.size(), 0);
-    for (auto &arm_pair : empirical_values) {
-        auto arm_value = arm_pair.first;
-        auto arm_idx = arm_pair.second;
+    executor.parallel_for(num_chunks, [&](size_t c) {
+        for (auto r = c * arms_votes.size() / num_chunks;
+             r < (c + 1) * arms_votes.size() / num_chunks; r++) {
+            arms_votes[r] = count_votes(votes, run_begins[r],
+                                        run_begins[r + 1]);
+        }
+    });
 
-        arms_total[arm_idx] += arm_value;
-        arms_count[arm_idx] += 1;
+    // Rank the arms voted for by enough players first, then the other voted.
+    vector<MedianHeap::value_type> voted_values, other_values;
+    for (auto &arm_votes : arms_votes) {
+        auto value_arm_pair = make_pair(arm_votes.value, arm_votes.arm_idx);
+        if (arm_votes.count > sqrt(this->_num_players)) {
+            voted_values.push_back(value_arm_pair);
+        } else {
+            other_values.push_back(value_arm_pair);
+        }
     }
 
-    auto best_arm_idx = bandit.size() - 1;
-    auto best_arm_value = 0.0;
-    for (size_t i = 0; i < bandit.size(); i++) {
-        if (arms_count[i] > sqrt(this->_num_players)) {
-            auto arm_value = arms_total[i] / arms_count[i];
-            if (arm_value > best_arm_value) {
-                best_arm_value = arm_value;
-                best_arm_idx = i;
-            }
+    auto top_idxs = take_top(voted_values, k);
+    if (top_idxs.size() < k) {
+        for (auto &idx : take_top(other_values, k - top_idxs.size())) {
+            top_idxs.push_back(idx);
+        }
+    }
+
+    // Fill up with arbitrary arms, from the last one, if there is too few.
+    // Look the voted arms up in a sorted copy, not by a linear find.
+    auto sorted_top_idxs = top_idxs;
+    sort(sorted_top_idxs.begin(), sorted_top_idxs.end());
+    for (size_t i = bandit.size(); i > 0 && top_idxs.size() < k; i--) {
+        if (!binary_search(sorted_top_idxs.begin(), sorted_top_idxs.end(),
+                           i - 1)) {
+            top_idxs.push_back(i - 1);
         }
     }
 
-    return best_arm_idx;
+    return top_idxs;
+}
+
+/**
+ * Average the players' empirical values of the arms.
+ */
+static vector<MedianHeap::value_type>
+average_players_values(const vector<vector<double>> &empirical_values,
+                       const vector<size_t> &arm_idxs)
+{
+    vector<MedianHeap::value_type> average_values;
+    for (auto &arm_idx : arm_idxs) {
+        double average_value = 0;
+        for (auto &player_values : empirical_values) {
+            average_value += player_values[arm_idx];
+        }
+        average_values.push_back(
+            make_pair(average_value / empirical_values.size(), arm_idx));
+    }
+
+    return average_values;
+}
+
+/**
+ * Take the players' values of the arms, in the shape of a checkpoint.
+ */
+static vector<vector<double>>
+gather_values(const vector<vector<double>> &players_values,
+              const vector<size_t> &arm_idxs)
+{
+    vector<vector<double>> gathered_values(players_values.size());
+    for (size_t p_idx = 0; p_idx < players_values.size(); p_idx++) {
+        for (auto &arm_idx : arm_idxs) {
+            gathered_values[p_idx].push_back(players_values[p_idx][arm_idx]);
+        }
+    }
+
+    return gathered_values;
+}
+
+/**
+ * Put the players' values of the arms from a checkpoint back.
+ */
+static void
+scatter_values(const vector<vector<double>> &gathered_values,
+               const vector<size_t> &arm_idxs,
+               vector<vector<double>> &players_values)
+{
+    for (size_t p_idx = 0; p_idx < players_values.size(); p_idx++) {
+        for (size_t i = 0; i < arm_idxs.size(); i++) {
+            players_values[p_idx][arm_idxs[i]] = gathered_values[p_idx][i];
+        }
+    }
+}
+
+/**
+ * Pull each arm `num_pulls` times with `pull` and fold the average returns
+ * into the player's running averages of the rounds.
+ */
+template <typename Pull>
+static void
+play_round(const vector<shared_ptr<IBanditArm>> &bandit,
+           const vector<size_t> &arm_idxs, double num_pulls, int round,
+           vector<double> &player_values, Pull pull)
+{
+    for (auto &arm_idx : arm_idxs) {
+        auto &arm = *bandit[arm_idx];
+
+        double total_return = 0;
+        for (auto i = 0; i < num_pulls; i++) {
+            total_return += pull(arm);
+        }
+
+        auto average_return = total_return / num_pulls;
+        player_values[arm_idx] +=
+            (average_return - player_values[arm_idx]) / round;
+    }
+}
+
+/**
+ * Pull each arm `num_pulls` times with `pull` and add the returns and the
+ * squared returns to the player's totals.
+ */
+template <typename Pull>
+static void
+play_round_squares(const vector<shared_ptr<IBanditArm>> &bandit,
+                   const vector<size_t> &arm_idxs, double num_pulls,
+                   vector<double> &player_returns,
+                   vector<double> &player_squares, Pull pull)
+{
+    for (auto &arm_idx : arm_idxs) {
+        auto &arm = *bandit[arm_idx];
+
+        double total_return = 0, total_square = 0;
+        for (auto i = 0; i < num_pulls; i++) {
+            auto reward = pull(arm);
+            total_return += reward;
+            total_square += reward * reward;
+        }
+
+        player_returns[arm_idx] += total_return;
+        player_squares[arm_idx] += total_square;
+    }
+}
+
+MultiRoundState
+MultiRoundEpsilonArm::make_problem(
+    const vector<shared_ptr<IBanditArm>> &bandit, size_t k) const
+{
+    MultiRoundState problem = {};
+    problem.num_arms = bandit.size();
+    problem.num_players = this->_num_players;
+    problem.num_top = k;
+    problem.bound = this->_bound;
+    problem.target_epsilon = this->_epsilon;
+    problem.delta = this->_delta;
+    problem.seed = this->_seed;
+
+    return problem;
 }
 
 size_t
 MultiRoundEpsilonArm::solve(const vector<shared_ptr<IBanditArm>> &bandit,
-                       size_t &total_pulls) const
+                            size_t &total_pulls) const
 {
+    return this->solve_topk(bandit, 1, total_pulls)[0];
+}
+
+vector<size_t>
+MultiRoundEpsilonArm::solve_topk(const vector<shared_ptr<IBanditArm>> &bandit,
+                                 size_t k, size_t &total_pulls) const
+{
+    if (k == 0) {
+        return vector<size_t>();
+    }
+    if (this->_bound == Bound::EmpiricalBernstein) {
+        return this->solve_topk_bernstein(bandit, k, total_pulls);
+    }
+
     int round = 1;
     double epsilon = 1, time = 0;
+    size_t my_pulls = 0;
+    auto &executor = Executor::get_shared();
 
     vector<size_t> current_idxs(bandit.size());
     iota(current_idxs.begin(), current_idxs.end(), 0);
+    vector<MedianHeap::value_type> current_values;
 
     // 2D vector of the shape: num. players x num. arms.
     vector<vector<double>> empirical_values(this->_num_players,
                                             vector<double>(bandit.size(), 0));
-    
-    while (current_idxs.size() > 1 && epsilon > (this->_epsilon / 2)) {
+
+    // Resume from the checkpoint of the same problem, if there is one.
+    bool is_checkpointed = !this->_checkpoint_path.empty();
+    CheckpointWriter checkpoint_writer(this->_checkpoint_path);
+    auto problem = this->make_problem(bandit, k);
+    MultiRoundState state;
+    if (is_checkpointed &&
+        load_checkpoint(this->_checkpoint_path, state) &&
+        is_same_problem(state, problem)) {
+        round = state.round;
+        epsilon = state.epsilon;
+        time = state.time;
+        my_pulls = state.pulls;
+        total_pulls += my_pulls;
+        current_idxs = state.current_idxs;
+        scatter_values(state.empirical_values, current_idxs,
+                       empirical_values);
+        if (round > 1) {
+            current_values = average_players_values(empirical_values,
+                                                    current_idxs);
+        }
+    }
+
+    while (current_idxs.size() > k && epsilon > (this->_epsilon / 2)) {
         auto time_old = time;
         epsilon = pow(2, -round);
         time = (2 / (this->_num_players * pow(epsilon, 2))) *
             log((4 * bandit.size() * pow(round, 2)) / this->_delta);
         auto num_pulls = ceil(time - time_old);
 
-        total_pulls += this->_num_players * current_idxs.size() * num_pulls;
+        auto round_pulls = this->_num_players * current_idxs.size() * num_pulls;
+        total_pulls += round_pulls;
+        my_pulls += round_pulls;
         if (total_pulls > this->_limit_pulls) {
-            // Halt and return an arbitrary arm;
-            return current_idxs[0];
+            // Halt and return arbitrary arms;
+            current_idxs.resize(k);
+            return current_idxs;
         }
 
-        #pragma omp parallel \
-            num_threads(this->_num_players) \
-            firstprivate(bandit, current_idxs, num_pulls) \
-            shared(empirical_values)
-        {
-            auto my_idx = omp_get_thread_num();
-            for (auto &arm_idx : current_idxs) {
-                auto &arm = bandit[arm_idx];
+        // Players are tasks of the shared executor, not threads.
+        executor.parallel_for(this->_num_players, [&](size_t my_idx) {
+            auto &my_values = empirical_values[my_idx];
+            if (this->_is_seeded) {
+                auto rnd_gen = make_player_engine(this->_seed, round, my_idx);
+                play_round(bandit, current_idxs, num_pulls, round, my_values,
+                           [&](const IBanditArm &arm) {
+                               return arm.pull(rnd_gen);
+                           });
+            } else {
+                play_round(bandit, current_idxs, num_pulls, round, my_values,
+                           [](const IBanditArm &arm) { return arm.pull(); });
+            }
+        });
 
-                double total_return = 0;
-                for (auto i = 0; i < num_pulls; i++) {
-                    total_return += arm->pull();
-                }
+        current_values = average_players_values(empirical_values,
+                                                current_idxs);
+        select_top(current_values, k);
+        auto kth_value = current_values[k - 1].first;
 
-                auto average_return = total_return / num_pulls;
-                empirical_values[my_idx][arm_idx] +=
-                    (average_return - empirical_values[my_idx][arm_idx]) /
-                    round;
+        vector<MedianHeap::value_type> subset_values;
+        for (auto &value_arm_pair : current_values) {
+            if (value_arm_pair.first >= (kth_value - epsilon)) {
+                subset_values.push_back(value_arm_pair);
             }
         }
 
-        vector<double> average_values(bandit.size(), 0);
+        // Bookkeeping.
+        round += 1;
+        swap(current_values, subset_values);
+        current_idxs.clear();
+        for (auto &value_arm_pair : current_values) {
+            current_idxs.push_back(value_arm_pair.second);
+        }
+
+        if (is_checkpointed) {
+            // Snapshot the round boundary, it's saved in the background.
+            state = problem;
+            state.round = round;
+            state.epsilon = epsilon;
+            state.time = time;
+            state.pulls = my_pulls;
+            state.current_idxs = current_idxs;
+            state.empirical_values = gather_values(empirical_values,
+                                                   current_idxs);
+            checkpoint_writer.save(move(state));
+        }
+    }
+
+    if (is_checkpointed) {
+        checkpoint_writer.remove();
+    }
+
+    if (current_values.empty()) {
+        // No arm was pulled, return arbitrary arms.
+        current_idxs.resize(min(k, current_idxs.size()));
+        return current_idxs;
+    }
+
+    return take_top(current_values, k);
+}
+
+vector<size_t>
+MultiRoundEpsilonArm::solve_topk_bernstein(
+    const vector<shared_ptr<IBanditArm>> &bandit, size_t k,
+    size_t &total_pulls) const
+{
+    int round = 1;
+    double time = 0, arm_pulls = 0;
+    size_t my_pulls = 0;
+    auto &executor = Executor::get_shared();
+
+    vector<size_t> current_idxs(bandit.size());
+    iota(current_idxs.begin(), current_idxs.end(), 0);
+
+    // 2D vectors of the shape: num. players x num. arms.
+    vector<vector<double>> total_returns(this->_num_players,
+                                         vector<double>(bandit.size(), 0));
+    vector<vector<double>> total_squares(this->_num_players,
+                                         vector<double>(bandit.size(), 0));
+
+    // Union bound over the arms and rounds, then split between the
+    // Hoeffding and the empirical Bernstein bounds.
+    auto round_delta = [&](int round) {
+        return this->_delta / (2 * bandit.size() * pow(round, 2)) / 2;
+    };
+
+    // The confidence radius of each current arm.
+    vector<MedianHeap::value_type> average_values;
+    vector<double> radiuses;
+    auto update_bounds = [&](int round) {
+        auto delta = round_delta(round);
+        average_values.clear();
+        radiuses.clear();
         for (auto &arm_idx : current_idxs) {
+            double total_return = 0, total_square = 0;
             for (auto p_idx = 0; p_idx < this->_num_players; p_idx++) {
-                average_values[arm_idx] += empirical_values[p_idx][arm_idx];
+                total_return += total_returns[p_idx][arm_idx];
+                total_square += total_squares[p_idx][arm_idx];
+            }
+
+            auto variance = sample_variance(total_return, total_square,
+                                            arm_pulls);
+            auto radius = min(hoeffding_radius(arm_pulls, delta),
+                              bernstein_radius(arm_pulls, variance, delta));
+
+            average_values.push_back(
+                make_pair(total_return / arm_pulls, arm_idx));
+            radiuses.push_back(radius);
+        }
+    };
+
+    // Resume from the checkpoint of the same problem, if there is one.
+    bool is_checkpointed = !this->_checkpoint_path.empty();
+    CheckpointWriter checkpoint_writer(this->_checkpoint_path);
+    auto problem = this->make_problem(bandit, k);
+    MultiRoundState state;
+    bool is_accurate = false;
+    if (is_checkpointed &&
+        load_checkpoint(this->_checkpoint_path, state) &&
+        is_same_problem(state, problem)) {
+        round = state.round;
+        time = state.time;
+        arm_pulls = state.arm_pulls;
+        my_pulls = state.pulls;
+        total_pulls += my_pulls;
+        current_idxs = state.current_idxs;
+        scatter_values(state.empirical_values, current_idxs, total_returns);
+        scatter_values(state.empirical_squares, current_idxs, total_squares);
+        if (round > 1) {
+            update_bounds(round - 1);
+            is_accurate = *max_element(radiuses.begin(), radiuses.end()) <=
+                this->_epsilon / 2;
+        }
+    }
+
+    while (current_idxs.size() > k && !is_accurate) {
+        auto time_old = time;
+        auto epsilon = pow(2, -round);
+        time = (2 / (this->_num_players * pow(epsilon, 2))) *
+            log((4 * bandit.size() * pow(round, 2)) / this->_delta);
+        auto num_pulls = ceil(time - time_old);
+
+        auto round_pulls = this->_num_players * current_idxs.size() * num_pulls;
+        total_pulls += round_pulls;
+        my_pulls += round_pulls;
+        if (total_pulls > this->_limit_pulls) {
+            // Halt and return arbitrary arms;
+            current_idxs.resize(k);
+            return current_idxs;
+        }
+
+        // Players are tasks of the shared executor, not threads.
+        executor.parallel_for(this->_num_players, [&](size_t my_idx) {
+            auto &my_returns = total_returns[my_idx];
+            auto &my_squares = total_squares[my_idx];
+            if (this->_is_seeded) {
+                auto rnd_gen = make_player_engine(this->_seed, round, my_idx);
+                play_round_squares(bandit, current_idxs, num_pulls,
+                                   my_returns, my_squares,
+                                   [&](const IBanditArm &arm) {
+                                       return arm.pull(rnd_gen);
+                                   });
+            } else {
+                play_round_squares(bandit, current_idxs, num_pulls,
+                                   my_returns, my_squares,
+                                   [](const IBanditArm &arm) {
+                                       return arm.pull();
+                                   });
             }
-            average_values[arm_idx] /= this->_num_players;
+        });
+        arm_pulls += this->_num_players * num_pulls;
+
+        update_bounds(round);
+        vector<double> lcbs;
+        for (size_t i = 0; i < average_values.size(); i++) {
+            lcbs.push_back(average_values[i].first - radiuses[i]);
         }
-        auto best_value = *max_element(average_values.begin(),
-                                       average_values.end());
-        
+        nth_element(lcbs.begin(), lcbs.begin() + (k - 1), lcbs.end(),
+                    greater<double>());
+        auto kth_lcb = lcbs[k - 1];
+
+        // Keep arms which still can be in the top k.
         vector<size_t> subset_idxs;
-        for (auto &arm_idx : current_idxs) {
-            if (average_values[arm_idx] >= (best_value - epsilon)) {
-                subset_idxs.push_back(arm_idx);
+        vector<MedianHeap::value_type> subset_values;
+        double max_radius = 0;
+        for (size_t i = 0; i < average_values.size(); i++) {
+            if (average_values[i].first + radiuses[i] >= kth_lcb) {
+                subset_idxs.push_back(average_values[i].second);
+                subset_values.push_back(average_values[i]);
+                max_radius = max(max_radius, radiuses[i]);
             }
         }
-        
+
         // Bookkeeping.
         round += 1;
         swap(current_idxs, subset_idxs);
+        swap(average_values, subset_values);
+        // All survivors are within ε/2, the best looking are ε-optimal.
+        is_accurate = max_radius <= this->_epsilon / 2;
+
+        if (is_checkpointed) {
+            // Snapshot the round boundary, it's saved in the background.
+            state = problem;
+            state.round = round;
+            state.epsilon = epsilon;
+            state.time = time;
+            state.pulls = my_pulls;
+            state.arm_pulls = arm_pulls;
+            state.current_idxs = current_idxs;
+            state.empirical_values = gather_values(total_returns,
+                                                   current_idxs);
+            state.empirical_squares = gather_values(total_squares,
+                                                    current_idxs);
+            checkpoint_writer.save(move(state));
+        }
     }
-    
-    return current_idxs[0];
+
+    if (is_checkpointed) {
+        checkpoint_writer.remove();
+    }
+
+    if (average_values.empty()) {
+        // No arm was pulled, return arbitrary arms.
+        current_idxs.resize(min(k, current_idxs.size()));
+        return current_idxs;
+    }
+
+    return take_top(average_values, k);
+}
+
+/**
+ * Pooled statistics of an arm, shared by all players.
+ *
+ * The epoch is odd during a write, so the readers retry instead of reading
+ * a torn (sum, count) pair. Writers take the odd epoch with a CAS, so they
+ * only wait for each other on the same arm.
+ */
+struct ArmSlot {
+    atomic<uint64_t> epoch;
+    atomic<double> sum;
+    atomic<uint64_t> count;
+};
+
+static void
+write_slot(ArmSlot &slot, double total_return, uint64_t num_pulls)
+{
+    uint64_t epoch;
+    do {
+        epoch = slot.epoch.load(memory_order_relaxed) & ~1ull;
+    } while (!slot.epoch.compare_exchange_weak(epoch, epoch + 1,
+                                               memory_order_acquire,
+                                               memory_order_relaxed));
+    atomic_thread_fence(memory_order_release);
+    slot.sum.store(slot.sum.load(memory_order_relaxed) + total_return,
+                   memory_order_relaxed);
+    slot.count.store(slot.count.load(memory_order_relaxed) + num_pulls,
+                     memory_order_relaxed);
+    slot.epoch.store(epoch + 2, memory_order_release);
+}
+
+/**
+ * Read the average return of the arm and its number of pulls.
+ */
+static double
+read_slot(const ArmSlot &slot, double &num_pulls)
+{
+    uint64_t epoch_begin, epoch_end, count;
+    double sum;
+    do {
+        epoch_begin = slot.epoch.load(memory_order_acquire);
+        sum = slot.sum.load(memory_order_relaxed);
+        count = slot.count.load(memory_order_relaxed);
+        atomic_thread_fence(memory_order_acquire);
+        epoch_end = slot.epoch.load(memory_order_relaxed);
+    } while ((epoch_begin & 1) || epoch_begin != epoch_end);
+
+    num_pulls = count;
+    return count > 0 ? sum / count : 0;
+}
+
+/**
+ * Anytime Hoeffding confidence radius, union bounded over arms and pulls.
+ */
+static double
+confidence_radius(double num_pulls, size_t num_arms, double delta)
+{
+    if (num_pulls == 0) {
+        return numeric_limits<double>::infinity();
+    }
+
+    return sqrt(log(4 * num_arms * pow(num_pulls, 2) / delta) /
+                (2 * num_pulls));
+}
+
+size_t
+AsyncMultiRoundEpsilonArm::solve(
+    const vector<shared_ptr<IBanditArm>> &bandit, size_t &total_pulls) const
+{
+    return this->solve_topk(bandit, 1, total_pulls)[0];
+}
+
+vector<size_t>
+AsyncMultiRoundEpsilonArm::solve_topk(
+    const vector<shared_ptr<IBanditArm>> &bandit, size_t k,
+    size_t &total_pulls) const
+{
+    const auto num_arms = bandit.size();
+    const auto num_words = (num_arms + 63) / 64;
+
+    if (k == 0) {
+        return vector<size_t>();
+    }
+    if (num_arms <= k) {
+        vector<size_t> all_idxs(num_arms);
+        iota(all_idxs.begin(), all_idxs.end(), 0);
+        return all_idxs;
+    }
+
+    // Statistics pooled over the players, one slot per arm.
+    unique_ptr<ArmSlot[]> arm_slots(new ArmSlot[num_arms]());
+
+    // Survivor bitmap, any player can clear any arm's bit.
+    vector<atomic<uint64_t>> survivors(num_words);
+    for (size_t w = 0; w < num_words; w++) {
+        auto num_bits = min<size_t>(num_arms - 64 * w, 64);
+        survivors[w].store(num_bits == 64 ? ~0ull : (1ull << num_bits) - 1);
+    }
+    atomic<size_t> num_survivors(num_arms);
+
+    atomic<size_t> pulls_count(0);
+    atomic<bool> is_done(false);
+
+    // Clear the arm's bit, unless only k arms would be left. The count is
+    // reserved first and given back if another player cleared the bit.
+    auto eliminate = [&](size_t arm_idx) {
+        auto count = num_survivors.load();
+        while (count > k &&
+               !num_survivors.compare_exchange_weak(count, count - 1)) { }
+        if (count <= k) {
+            return;
+        }
+
+        auto mask = 1ull << (arm_idx % 64);
+        auto word = survivors[arm_idx / 64].fetch_and(~mask,
+                                                      memory_order_relaxed);
+        if ((word & mask) == 0) {
+            num_survivors.fetch_add(1);
+        }
+    };
+
+    // Players are tasks of the shared executor. A player queued behind the
+    // others would only start when they're done, so no more players than
+    // the executor runs at once are started, and the rounds split the
+    // pulls between them.
+    auto &executor = Executor::get_shared();
+    auto num_players = min(this->_num_players, executor.get_concurrency());
+    executor.parallel_for(num_players, [&](size_t my_idx) {
+        // Start the passes apart, so the players rarely write the same slot.
+        auto first_word = my_idx * num_words / num_players;
+        int round = 0;
+        double time = 0;
+        vector<size_t> arm_idxs;
+        vector<double> values, radiuses, lcbs;
+
+        while (!is_done.load(memory_order_acquire)) {
+            // Follow the MultiRoundEpsilonArm schedule.
+            round += 1;
+            auto time_old = time;
+            auto epsilon = pow(2, -round);
+            time = (2 / (num_players * pow(epsilon, 2))) *
+                log((4 * num_arms * pow(round, 2)) / this->_delta);
+            uint64_t num_pulls = ceil(time - time_old);
+
+            // Pull the surviving arms without waiting for the other players.
+            size_t my_pulls = 0;
+            for (size_t i = 0; i < num_words; i++) {
+                auto w = (first_word + i) % num_words;
+                auto word = survivors[w].load(memory_order_relaxed);
+                for (size_t b = 0; word != 0; b++, word >>= 1) {
+                    if ((word & 1) == 0) {
+                        continue;
+                    }
+
+                    auto arm_idx = 64 * w + b;
+                    auto &arm = bandit[arm_idx];
+                    double total_return = 0;
+                    for (uint64_t i = 0; i < num_pulls; i++) {
+                        total_return += arm->pull();
+                    }
+                    write_slot(arm_slots[arm_idx], total_return, num_pulls);
+                    my_pulls += num_pulls;
+                }
+            }
+            auto pulls_so_far = pulls_count.fetch_add(my_pulls) + my_pulls;
+
+            // Read the pooled pulls of all survivors. A descheduled player
+            // only holds back its own pulls, the bounds hold at any time.
+            arm_idxs.clear();
+            values.clear();
+            radiuses.clear();
+            lcbs.clear();
+            for (size_t w = 0; w < num_words; w++) {
+                auto word = survivors[w].load(memory_order_relaxed);
+                for (size_t b = 0; word != 0; b++, word >>= 1) {
+                    if ((word & 1) == 0) {
+                        continue;
+                    }
+
+                    auto arm_idx = 64 * w + b;
+                    double arm_pulls;
+                    auto value = read_slot(arm_slots[arm_idx], arm_pulls);
+                    auto radius = confidence_radius(arm_pulls, num_arms,
+                                                    this->_delta);
+                    arm_idxs.push_back(arm_idx);
+                    values.push_back(value);
+                    radiuses.push_back(radius);
+                    lcbs.push_back(value - radius);
+                }
+            }
+            if (arm_idxs.size() <= k) {
+                is_done.store(true, memory_order_release);
+                break;
+            }
+
+            nth_element(lcbs.begin(), lcbs.begin() + (k - 1), lcbs.end(),
+                        greater<double>());
+            auto kth_lcb = lcbs[k - 1];
+
+            // Eliminate any survivor which is surely not in the top k.
+            double max_radius = 0;
+            for (size_t i = 0; i < arm_idxs.size(); i++) {
+                if (values[i] + radiuses[i] < kth_lcb) {
+                    eliminate(arm_idxs[i]);
+                } else {
+                    max_radius = max(max_radius, radiuses[i]);
+                }
+            }
+
+            // Stop when k arms are left, all survivors are (ε/2)-accurate or
+            // the pulls limit is exceeded.
+            if (num_survivors.load() <= k ||
+                max_radius <= this->_epsilon / 2 ||
+                pulls_so_far > this->_limit_pulls) {
+                is_done.store(true, memory_order_release);
+            }
+        }
+    });
+
+    total_pulls += pulls_count.load();
+
+    // Pick the top k arms from the survivors.
+    vector<MedianHeap::value_type> survivors_values;
+    for (size_t arm_idx = 0; arm_idx < num_arms; arm_idx++) {
+        auto mask = 1ull << (arm_idx % 64);
+        if (survivors[arm_idx / 64].load() & mask) {
+            double arm_pulls;
+            auto value = read_slot(arm_slots[arm_idx], arm_pulls);
+            survivors_values.push_back(make_pair(value, arm_idx));
+        }
+    }
+
+    return take_top(survivors_values, k);
 }
@@ -1,5 +1,7 @@
 #pragma once
+#include <cstdint>
 #include <memory>
+#include <string>
 #include <vector>
 
 #include "bandits.hpp"
@@ -8,6 +10,17 @@ using namespace std;
 
 namespace bandits
 {
+    struct MultiRoundState;
+
+    /**
+     * Confidence bound the elimination thresholds are based on.
+     *
+     * Hoeffding bounds only use the [0, 1] range of the rewards. Empirical
+     * Bernstein bounds also track the sum of squares of the rewards, so
+     * fewer pulls are needed to eliminate low-variance arms.
+     */
+    enum class Bound { Hoeffding, EmpiricalBernstein };
+
     class IAlgorithm
     {
     public:
@@ -32,6 +45,32 @@ namespace bandits
         solve(const vector<shared_ptr<IBanditArm>> &bandit,
               size_t &total_pulls) const = 0;
 
+        /**
+         * Identify the top-k arms of the Multi-Armed Bandit problem.
+         *
+         * @param bandit Vector of bandit arms to pull.
+         * @param k Number of arms to identify.
+         * @return Indexes of min(k, bandit.size()) (ε-)optimal arms, ordered
+         *     from the best one when their empirical values are known.
+         */
+        virtual vector<size_t>
+        solve_topk(const vector<shared_ptr<IBanditArm>> &bandit,
+                   size_t k) const = 0;
+
+        /**
+         * Identify the top-k arms of the Multi-Armed Bandit problem.
+         *
+         * @param[in] bandit Vector of bandit arms to pull.
+         * @param[in] k Number of arms to identify.
+         * @param[in, out] total_pulls Total number of arm pulls to the present
+         *     moment.
+         * @return Indexes of min(k, bandit.size()) (ε-)optimal arms, ordered
+         *     from the best one when their empirical values are known.
+         */
+        virtual vector<size_t>
+        solve_topk(const vector<shared_ptr<IBanditArm>> &bandit, size_t k,
+                   size_t &total_pulls) const = 0;
+
         virtual ~IAlgorithm() = default;
     };
 
@@ -56,6 +95,7 @@ namespace bandits
         //       `solve` in the IAlgorithm interface.
         // Source: https://stackoverflow.com/a/1896864/7983111
         using IAlgorithm::solve;
+        using IAlgorithm::solve_topk;
 
         size_t
         solve(const vector<shared_ptr<IBanditArm>> &bandit) const override
@@ -64,6 +104,14 @@ namespace bandits
             return this->solve(bandit, total_pulls);
         }
 
+        vector<size_t>
+        solve_topk(const vector<shared_ptr<IBanditArm>> &bandit,
+                   size_t k) const override
+        {
+            size_t total_pulls = 0;
+            return this->solve_topk(bandit, k, total_pulls);
+        }
+
     protected:
         const double _epsilon, _delta;
         const size_t _limit_pulls;
@@ -72,27 +120,68 @@ namespace bandits
     class MedianElimination : public PACAlgorithm
     {
     public:
-        MedianElimination(double epsilon, double delta, size_t limit_pulls) :
-            PACAlgorithm(epsilon, delta, limit_pulls) { }
+        /**
+         * @param bound With the empirical Bernstein bound, each round pulls
+         *     an arm until its estimate is accurate enough for the round,
+         *     but no more than with the Hoeffding bound.
+         */
+        MedianElimination(double epsilon, double delta, size_t limit_pulls,
+                          Bound bound = Bound::Hoeffding) :
+            PACAlgorithm(epsilon, delta, limit_pulls), _bound(bound) { }
 
         using PACAlgorithm::solve; // Use the base class implementation;
+        using PACAlgorithm::solve_topk;
 
         size_t
         solve(const vector<shared_ptr<IBanditArm>> &bandit,
               size_t &total_pulls) const override;
+
+        vector<size_t>
+        solve_topk(const vector<shared_ptr<IBanditArm>> &bandit, size_t k,
+                   size_t &total_pulls) const override;
+
+    private:
+        const Bound _bound;
     };
 
     class ExpGapElimination : public PACAlgorithm
     {
     public:
-        ExpGapElimination(double epsilon, double delta, size_t limit_pulls) :
-            PACAlgorithm(epsilon, delta, limit_pulls) { }
+        /**
+         * @param bound With the empirical Bernstein bound, `solve` and
+         *     `solve_topk` pull each arm in doubling batches until its
+         *     estimate is accurate enough for the round, but no more than
+         *     with the Hoeffding bound (at half the δ). The nested
+         *     MedianElimination uses the same bound.
+         */
+        ExpGapElimination(double epsilon, double delta, size_t limit_pulls,
+                          Bound bound = Bound::Hoeffding) :
+            PACAlgorithm(epsilon, delta, limit_pulls), _bound(bound) { }
         
         using PACAlgorithm::solve; // Use the base class implementation;
+        using PACAlgorithm::solve_topk;
 
         size_t
         solve(const vector<shared_ptr<IBanditArm>> &bandit,
               size_t &total_pulls) const override;
+
+        vector<size_t>
+        solve_topk(const vector<shared_ptr<IBanditArm>> &bandit, size_t k,
+                   size_t &total_pulls) const override;
+
+    private:
+        /**
+         * Evaluate the arms for the round and count the pulls made.
+         *
+         * @param[out] is_halted The pulls limit cut the evaluation short.
+         */
+        vector<double>
+        evaluate_round(const vector<shared_ptr<IBanditArm>> &bandit,
+                       const vector<size_t> &arm_idxs, int num_pulls,
+                       double epsilon, double delta, size_t &total_pulls,
+                       bool &is_halted) const;
+
+        const Bound _bound;
     };
 
     class OneRoundBestArm : public IAlgorithm
@@ -108,7 +197,7 @@ namespace bandits
          * See: Hillel, E., Karnin, Z., Koren, T., Lempel, R., and Somekh, O.,
          *      “Distributed Exploration in Multi-Armed Bandits”, 2013.
          *
-         * @param num_players Number of OpenMP threads.
+         * @param num_players Number of players, tasks of the shared executor.
          * @param time_horizon Limit of arm pulls per player.
          */
         OneRoundBestArm(int num_players, size_t time_horizon) :
@@ -127,6 +216,18 @@ namespace bandits
         solve(const vector<shared_ptr<IBanditArm>> &bandit,
               size_t &total_pulls) const override;
 
+        vector<size_t>
+        solve_topk(const vector<shared_ptr<IBanditArm>> &bandit,
+                   size_t k) const override
+        {
+            size_t total_pulls = 0;
+            return this->solve_topk(bandit, k, total_pulls);
+        }
+
+        vector<size_t>
+        solve_topk(const vector<shared_ptr<IBanditArm>> &bandit, size_t k,
+                   size_t &total_pulls) const override;
+
     private:
         const int _num_players;
         const size_t _time_horizon;
@@ -141,24 +242,122 @@ namespace bandits
          * See: Hillel, E., Karnin, Z., Koren, T., Lempel, R., and Somekh, O.,
          *      “Distributed Exploration in Multi-Armed Bandits”, 2013.
          *
-         * @param num_players Number of OpenMP threads.
+         * @param num_players Number of players, tasks of the shared executor.
+         * @param epsilon Find an arm that is at most ε worse than the optimal
+         *     arm in terms of the expected value (bounded between [0, 1]).
+         * @param delta With probability of at least 1-δ find an ε-optimal arm.
+         * @param limit_pulls Don't pull all arms more then this amount.
+         *     If the limit is exceeded, then `solve` returns an arbitrary arm!
+         * @param bound With the empirical Bernstein bound, `solve_topk` keeps
+         *     the round schedule, but eliminates arms whose upper bound is
+         *     below the k-th best lower bound, using the tighter of the
+         *     Hoeffding and empirical Bernstein bounds (each at half the δ),
+         *     and stops once all survivors are known within ε/2.
+         */
+        MultiRoundEpsilonArm(int num_players, double epsilon, double delta,
+                             size_t limit_pulls,
+                             Bound bound = Bound::Hoeffding) :
+            PACAlgorithm(epsilon, delta, limit_pulls),
+            _num_players(num_players), _bound(bound), _is_seeded(false),
+            _seed(0) { }
+
+        /**
+         * Initialize the seeded, checkpointed multi-round ε-arm solver.
+         *
+         * Players pull the arms with random engines derived from the seed,
+         * so a run is reproducible. The `solve` state is snapshotted in the
+         * background at every round boundary and, if the checkpoint of the
+         * same problem exists, `solve` resumes from it. The checkpoint is
+         * removed when `solve` finishes, but kept if it halts on the limit.
+         *
+         * @param num_players Number of players, tasks of the shared executor.
          * @param epsilon Find an arm that is at most ε worse than the optimal
          *     arm in terms of the expected value (bounded between [0, 1]).
          * @param delta With probability of at least 1-δ find an ε-optimal arm.
          * @param limit_pulls Don't pull all arms more then this amount.
          *     If the limit is exceeded, then `solve` returns an arbitrary arm!
+         * @param seed Seed of the players' random engines.
+         * @param checkpoint_path Path to the checkpoint file, empty to turn
+         *     the checkpointing off.
+         * @param bound As above, the empirical Bernstein state is
+         *     checkpointed with the sums of squares of the rewards.
          */
         MultiRoundEpsilonArm(int num_players, double epsilon, double delta,
-                             size_t limit_pulls) :
+                             size_t limit_pulls, uint64_t seed,
+                             const string &checkpoint_path,
+                             Bound bound = Bound::Hoeffding) :
+            PACAlgorithm(epsilon, delta, limit_pulls),
+            _num_players(num_players), _bound(bound),
+            _is_seeded(true), _seed(seed),
+            _checkpoint_path(checkpoint_path) { }
+
+        using PACAlgorithm::solve; // Use the base class implementation;
+        using PACAlgorithm::solve_topk;
+
+        size_t
+        solve(const vector<shared_ptr<IBanditArm>> &bandit,
+              size_t &total_pulls) const override;
+
+        vector<size_t>
+        solve_topk(const vector<shared_ptr<IBanditArm>> &bandit, size_t k,
+                   size_t &total_pulls) const override;
+
+    private:
+        /**
+         * The checkpoint state with only the problem fields set.
+         */
+        MultiRoundState
+        make_problem(const vector<shared_ptr<IBanditArm>> &bandit,
+                     size_t k) const;
+
+        vector<size_t>
+        solve_topk_bernstein(const vector<shared_ptr<IBanditArm>> &bandit,
+                             size_t k, size_t &total_pulls) const;
+
+        const int _num_players;
+        const Bound _bound;
+        const bool _is_seeded;
+        const uint64_t _seed;
+        const string _checkpoint_path;
+    };
+
+    class AsyncMultiRoundEpsilonArm : public PACAlgorithm
+    {
+    public:
+        /**
+         * Initialize the asynchronous distributed multi-round ε-arm solver.
+         *
+         * It is a barrier-free variant of MultiRoundEpsilonArm. Players don't
+         * wait for each other at the end of a round. They publish their pulls
+         * into shared, per-arm and epoch-versioned statistics, and any of
+         * them eliminates any arm from the survivor bitmap as soon as the
+         * pooled Hoeffding confidence intervals allow it, so a descheduled
+         * player doesn't hold back the elimination.
+         *
+         * @param num_players Number of players, tasks of the shared executor.
+         *     No more than it runs at once are started.
+         * @param epsilon Find an arm that is at most ε worse than the optimal
+         *     arm in terms of the expected value (bounded between [0, 1]).
+         * @param delta With probability of at least 1-δ find an ε-optimal arm.
+         * @param limit_pulls Don't pull all arms more then this amount.
+         *     If the limit is exceeded, then `solve` returns an arbitrary arm!
+         */
+        AsyncMultiRoundEpsilonArm(int num_players, double epsilon,
+                                  double delta, size_t limit_pulls) :
             PACAlgorithm(epsilon, delta, limit_pulls),
             _num_players(num_players) { }
-        
+
         using PACAlgorithm::solve; // Use the base class implementation;
+        using PACAlgorithm::solve_topk;
 
         size_t
         solve(const vector<shared_ptr<IBanditArm>> &bandit,
               size_t &total_pulls) const override;
 
+        vector<size_t>
+        solve_topk(const vector<shared_ptr<IBanditArm>> &bandit, size_t k,
+                   size_t &total_pulls) const override;
+
     private:
         const int _num_players;
     };
@@ -1,5 +1,6 @@
 #include <cstdlib>
 #include <memory>
+#include <random>
 
 #include "bandits.hpp"
 
@@ -12,6 +13,12 @@ double BernoulliArm::pull() const
     return (double) (r >= (1 - this->_value));
 }
 
+double BernoulliArm::pull(mt19937_64 &rnd_gen) const
+{
+    double r = uniform_real_distribution<double>(0, 1)(rnd_gen);
+    return (double) (r >= (1 - this->_value));
+}
+
 vector<shared_ptr<IBanditArm>>
 bandits::make_bernoulli_bandit(const vector<double> &expected_values)
 {
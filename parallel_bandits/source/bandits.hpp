@@ -1,4 +1,6 @@
 #pragma once
+#include <memory>
+#include <random>
 #include <vector>
 
 using namespace std;
@@ -9,6 +11,15 @@ namespace bandits
     {
     public:
         virtual double pull() const = 0;
+
+        /**
+         * Pull the arm with the given random engine, so pulls can be replayed.
+         *
+         * The seeded solvers only pull with it, so it must draw all its
+         * randomness from the engine, or a resumed run won't match.
+         */
+        virtual double pull(mt19937_64 &rnd_gen) const = 0;
+
         virtual ~IBanditArm() = default;
     };
     
@@ -18,6 +29,7 @@ namespace bandits
         BernoulliArm() = delete;
         BernoulliArm(double expected_value) : _value(expected_value) { };
         double pull() const override;
+        double pull(mt19937_64 &rnd_gen) const override;
 
     private:
         const double _value;
@@ -0,0 +1,210 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "checkpoint.hpp"
+#include "utils.hpp"
+
+using namespace std;
+using namespace bandits;
+
+static const char MAGIC[] = "PBCKPT03";
+
+template <typename T>
+static void pack(string &out, const T &value)
+{
+    out.append(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+template <typename T>
+static bool unpack(const string &in, size_t &offset, T &value)
+{
+    if (offset + sizeof(T) > in.size()) {
+        return false;
+    }
+
+    memcpy(&value, in.data() + offset, sizeof(T));
+    offset += sizeof(T);
+    return true;
+}
+
+mt19937_64 bandits::make_player_engine(uint64_t seed, int round, int player)
+{
+    seed_seq seeds = {
+        static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32),
+        static_cast<uint32_t>(round), static_cast<uint32_t>(player)
+    };
+
+    return mt19937_64(seeds);
+}
+
+bool bandits::save_checkpoint(const MultiRoundState &state,
+                              const string &path)
+{
+    string data(MAGIC, sizeof(MAGIC) - 1);
+    pack(data, state.num_arms);
+    pack(data, state.num_players);
+    pack(data, state.num_top);
+    pack(data, static_cast<int32_t>(state.bound));
+    pack(data, state.target_epsilon);
+    pack(data, state.delta);
+    pack(data, state.seed);
+    pack(data, state.round);
+    pack(data, state.epsilon);
+    pack(data, state.time);
+    pack(data, state.pulls);
+    pack(data, state.arm_pulls);
+
+    // Only the current arms' values are needed to resume.
+    pack(data, static_cast<uint64_t>(state.current_idxs.size()));
+    for (auto &arm_idx : state.current_idxs) {
+        pack(data, static_cast<uint64_t>(arm_idx));
+    }
+    for (auto &player_values : state.empirical_values) {
+        for (auto &value : player_values) {
+            pack(data, value);
+        }
+    }
+    for (auto &player_squares : state.empirical_squares) {
+        for (auto &square : player_squares) {
+            pack(data, square);
+        }
+    }
+    pack(data, fnv1a(data.data(), data.size()));
+
+    auto tmp_path = path + ".tmp";
+    {
+        ofstream file(tmp_path, ios::binary | ios::trunc);
+        file.write(data.data(), data.size());
+        if (!file.good()) {
+            return false;
+        }
+    }
+
+    return rename(tmp_path.c_str(), path.c_str()) == 0;
+}
+
+bool bandits::load_checkpoint(const string &path, MultiRoundState &state)
+{
+    ifstream file(path, ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    string data((istreambuf_iterator<char>(file)),
+                istreambuf_iterator<char>());
+
+    // Validate the magic and the checksum.
+    uint32_t checksum;
+    size_t offset = data.size() - sizeof(checksum);
+    if (data.size() < sizeof(MAGIC) - 1 + sizeof(checksum) ||
+        data.compare(0, sizeof(MAGIC) - 1, MAGIC) != 0 ||
+        !unpack(data, offset, checksum) ||
+        checksum != fnv1a(data.data(), data.size() - sizeof(checksum))) {
+        return false;
+    }
+    data.resize(data.size() - sizeof(checksum));
+
+    offset = sizeof(MAGIC) - 1;
+    int32_t bound;
+    uint64_t num_current;
+    if (!(unpack(data, offset, state.num_arms) &&
+          unpack(data, offset, state.num_players) &&
+          unpack(data, offset, state.num_top) &&
+          unpack(data, offset, bound) &&
+          unpack(data, offset, state.target_epsilon) &&
+          unpack(data, offset, state.delta) &&
+          unpack(data, offset, state.seed) &&
+          unpack(data, offset, state.round) &&
+          unpack(data, offset, state.epsilon) &&
+          unpack(data, offset, state.time) &&
+          unpack(data, offset, state.pulls) &&
+          unpack(data, offset, state.arm_pulls) &&
+          unpack(data, offset, num_current))) {
+        return false;
+    }
+
+    state.bound = static_cast<Bound>(bound);
+    if (state.bound != Bound::Hoeffding &&
+        state.bound != Bound::EmpiricalBernstein) {
+        return false;
+    }
+
+    // The squares are only saved with the Bernstein bound.
+    auto num_tables = (state.bound == Bound::EmpiricalBernstein) ? 2 : 1;
+    auto expected_size = offset + num_current * sizeof(uint64_t) +
+        num_tables * state.num_players * num_current * sizeof(double);
+    if (state.num_players <= 0 || data.size() != expected_size) {
+        return false;
+    }
+
+    state.current_idxs.resize(num_current);
+    for (auto &arm_idx : state.current_idxs) {
+        uint64_t idx;
+        if (!unpack(data, offset, idx) || idx >= state.num_arms) {
+            return false;
+        }
+        arm_idx = idx;
+    }
+    state.empirical_values.assign(state.num_players,
+                                  vector<double>(num_current));
+    for (auto &player_values : state.empirical_values) {
+        for (auto &value : player_values) {
+            if (!unpack(data, offset, value)) {
+                return false;
+            }
+        }
+    }
+    state.empirical_squares.clear();
+    if (state.bound == Bound::EmpiricalBernstein) {
+        state.empirical_squares.assign(state.num_players,
+                                       vector<double>(num_current));
+    }
+    for (auto &player_squares : state.empirical_squares) {
+        for (auto &square : player_squares) {
+            if (!unpack(data, offset, square)) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+bool bandits::is_same_problem(const MultiRoundState &a,
+                              const MultiRoundState &b)
+{
+    return a.num_arms == b.num_arms &&
+        a.num_players == b.num_players &&
+        a.num_top == b.num_top &&
+        a.bound == b.bound &&
+        a.target_epsilon == b.target_epsilon &&
+        a.delta == b.delta &&
+        a.seed == b.seed;
+}
+
+void CheckpointWriter::save(MultiRoundState state)
+{
+    this->wait();
+    this->_writer = thread([this](MultiRoundState state) {
+        save_checkpoint(state, this->_path);
+    }, move(state));
+}
+
+void CheckpointWriter::wait()
+{
+    if (this->_writer.joinable()) {
+        this->_writer.join();
+    }
+}
+
+void CheckpointWriter::remove()
+{
+    this->wait();
+    std::remove(this->_path.c_str());
+}
@@ -0,0 +1,106 @@
+#pragma once
+#include <cstdint>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "algorithms.hpp"
+
+using namespace std;
+
+namespace bandits
+{
+    /**
+     * State of `MultiRoundEpsilonArm::solve_topk` at a round boundary.
+     *
+     * The players' random engines are derived from (seed, round, player),
+     * so the state doesn't need to hold their stream positions.
+     */
+    struct MultiRoundState {
+        // Identify the problem, a checkpoint of another one isn't resumed.
+        uint64_t num_arms;
+        int32_t num_players;
+        // The k of `solve_topk`.
+        uint64_t num_top;
+        Bound bound;
+        double target_epsilon, delta;
+        uint64_t seed;
+
+        int32_t round;
+        double epsilon, time;
+        // Pulls made by the solver so far.
+        uint64_t pulls;
+        // Pulls of each current arm by all players, the Bernstein bound's.
+        double arm_pulls;
+        vector<size_t> current_idxs;
+        // Shape: num. players x current idxs. Running averages with the
+        // Hoeffding bound, total returns with the Bernstein bound.
+        vector<vector<double>> empirical_values;
+        // Same shape, total squared returns. Only with the Bernstein bound.
+        vector<vector<double>> empirical_squares;
+    };
+
+    /**
+     * Whether both states are of the same problem, so one can be resumed
+     * by the solver of the other.
+     */
+    bool is_same_problem(const MultiRoundState &a, const MultiRoundState &b);
+
+    /**
+     * Make the random engine of the player for the round.
+     */
+    mt19937_64 make_player_engine(uint64_t seed, int round, int player);
+
+    /**
+     * Save the state to a compact binary file.
+     *
+     * It's written to a temporary file first and then renamed, so the
+     * previous checkpoint survives a crash in the middle of writing.
+     *
+     * @return False if the file can't be written.
+     */
+    bool save_checkpoint(const MultiRoundState &state, const string &path);
+
+    /**
+     * Load the state saved with `save_checkpoint`.
+     *
+     * @param[in] path Path to the checkpoint file.
+     * @param[out] state The loaded state.
+     * @return False if the file is missing, truncated or corrupted.
+     */
+    bool load_checkpoint(const string &path, MultiRoundState &state);
+
+    /**
+     * Save checkpoints in the background, so the solver isn't stalled.
+     */
+    class CheckpointWriter {
+    public:
+        CheckpointWriter(const string &path) : _path(path) { }
+
+        CheckpointWriter() = delete;
+        CheckpointWriter(const CheckpointWriter &) = delete;
+        CheckpointWriter &operator=(const CheckpointWriter &) = delete;
+
+        /**
+         * Start saving the state, after the previous save has finished.
+         */
+        void save(MultiRoundState state);
+
+        /**
+         * Wait for the save in progress, if any.
+         */
+        void wait();
+
+        /**
+         * Wait for the save in progress and remove the checkpoint.
+         */
+        void remove();
+
+        ~CheckpointWriter() { this->wait(); }
+
+    private:
+        const string _path;
+        thread _writer;
+    };
+}
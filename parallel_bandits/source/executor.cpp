@@ -0,0 +1,227 @@
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "executor.hpp"
+
+using namespace std;
+using namespace bandits;
+
+// The executor and queue of the current worker thread, if it is one.
+static thread_local const Executor *current_executor = nullptr;
+static thread_local size_t current_queue_idx = 0;
+// Depth of the tasks the current thread is running, nested ones included.
+static thread_local int task_depth = 0;
+
+static mutex shared_lock;
+static unique_ptr<Executor> shared_executor;
+static ExecutorOptions shared_options = default_executor_options();
+
+ExecutorOptions bandits::default_executor_options()
+{
+    int num_cores = thread::hardware_concurrency();
+    ExecutorOptions options = {max(num_cores, 1) - 1, 1 << 10, true};
+
+    return options;
+}
+
+Executor::Executor(const ExecutorOptions &options) :
+    _options(options), _num_queued(0), _num_parked(0), _is_stopping(false)
+{
+    auto num_workers = max(options.num_workers, 0);
+    for (int i = 0; i <= num_workers; i++) {
+        this->_queues.emplace_back(new WorkerQueue());
+    }
+    for (int i = 0; i < num_workers; i++) {
+        this->_workers.emplace_back(&Executor::run_worker, this, i);
+    }
+}
+
+Executor::~Executor()
+{
+    this->_is_stopping.store(true);
+    {
+        lock_guard<mutex> lock(this->_park_lock);
+        this->_wake_up.notify_all();
+    }
+    for (auto &worker : this->_workers) {
+        worker.join();
+    }
+}
+
+void Executor::parallel_for(size_t num_tasks,
+                            const function<void(size_t)> &task)
+{
+    if (num_tasks == 0) {
+        return;
+    }
+    if (num_tasks == 1 || this->_workers.empty()) {
+        // Nobody could help, skip the queues.
+        task_depth++;
+        for (size_t i = 0; i < num_tasks; i++) {
+            task(i);
+        }
+        task_depth--;
+        return;
+    }
+
+    // Workers push to their own queue, outside callers to the last one.
+    auto queue_idx = (current_executor == this) ?
+        current_queue_idx : this->_workers.size();
+    auto &queue = *this->_queues[queue_idx];
+    atomic<size_t> num_pending(num_tasks);
+    {
+        lock_guard<mutex> lock(queue.lock);
+        for (size_t i = num_tasks; i > 0; i--) {
+            queue.jobs.push_back({&task, i - 1, &num_pending});
+        }
+    }
+    this->_num_queued.fetch_add(num_tasks);
+    this->wake_workers(num_tasks);
+
+    // Help with any job until ours are done.
+    while (num_pending.load(memory_order_acquire) > 0) {
+        Job job;
+        if (this->pop_job(queue_idx, job) ||
+            this->steal_job(queue_idx, job)) {
+            this->run_job(job);
+        } else {
+            this_thread::yield();
+        }
+    }
+}
+
+bool Executor::is_in_task()
+{
+    return task_depth > 0;
+}
+
+Executor &Executor::get_shared()
+{
+    lock_guard<mutex> lock(shared_lock);
+    if (!shared_executor) {
+        shared_executor.reset(new Executor(shared_options));
+    }
+
+    return *shared_executor;
+}
+
+bool Executor::configure_shared(const ExecutorOptions &options)
+{
+    lock_guard<mutex> lock(shared_lock);
+    if (shared_executor) {
+        return false;
+    }
+
+    shared_options = options;
+    return true;
+}
+
+ExecutorOptions Executor::get_shared_options()
+{
+    lock_guard<mutex> lock(shared_lock);
+    return shared_options;
+}
+
+void Executor::run_worker(size_t worker_idx)
+{
+    current_executor = this;
+    current_queue_idx = worker_idx;
+
+    int num_failures = 0;
+    while (!this->_is_stopping.load(memory_order_relaxed)) {
+        Job job;
+        if (this->pop_job(worker_idx, job) ||
+            this->steal_job(worker_idx, job)) {
+            this->run_job(job);
+            num_failures = 0;
+            continue;
+        }
+
+        num_failures++;
+        if (num_failures < this->_options.spin_count) {
+            continue;
+        }
+        if (!this->_options.is_parking) {
+            this_thread::yield();
+            continue;
+        }
+
+        // Park until a job is queued. The count is raised before the
+        // queued jobs are checked, so `wake_workers` can't miss us.
+        unique_lock<mutex> lock(this->_park_lock);
+        this->_num_parked.fetch_add(1);
+        this->_wake_up.wait(lock, [this]() {
+            return this->_num_queued.load() > 0 || this->_is_stopping.load();
+        });
+        this->_num_parked.fetch_sub(1);
+        num_failures = 0;
+    }
+}
+
+bool Executor::pop_job(size_t queue_idx, Job &job)
+{
+    auto &queue = *this->_queues[queue_idx];
+    lock_guard<mutex> lock(queue.lock);
+    if (queue.jobs.empty()) {
+        return false;
+    }
+
+    // The most recent job, its data is likely still in the cache.
+    job = queue.jobs.back();
+    queue.jobs.pop_back();
+    this->_num_queued.fetch_sub(1);
+    return true;
+}
+
+bool Executor::steal_job(size_t thief_idx, Job &job)
+{
+    if (this->_num_queued.load(memory_order_relaxed) == 0) {
+        return false;
+    }
+
+    auto num_queues = this->_queues.size();
+    for (size_t i = 1; i < num_queues; i++) {
+        auto &queue = *this->_queues[(thief_idx + i) % num_queues];
+        unique_lock<mutex> lock(queue.lock, try_to_lock);
+        if (!lock.owns_lock() || queue.jobs.empty()) {
+            continue;
+        }
+
+        // The oldest job, the owner is least likely to need it soon.
+        job = queue.jobs.front();
+        queue.jobs.pop_front();
+        this->_num_queued.fetch_sub(1);
+        return true;
+    }
+
+    return false;
+}
+
+void Executor::run_job(const Job &job)
+{
+    task_depth++;
+    (*job.task)(job.idx);
+    task_depth--;
+
+    job.num_pending->fetch_sub(1, memory_order_release);
+}
+
+void Executor::wake_workers(size_t num_jobs)
+{
+    if (this->_num_parked.load() == 0) {
+        return;
+    }
+
+    lock_guard<mutex> lock(this->_park_lock);
+    if (num_jobs == 1) {
+        this->_wake_up.notify_one();
+    } else {
+        this->_wake_up.notify_all();
+    }
+}
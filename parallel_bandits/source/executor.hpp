@@ -0,0 +1,121 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+namespace bandits
+{
+    struct ExecutorOptions {
+        // Worker threads, the thread calling `parallel_for` is another one.
+        int num_workers;
+        // Failed steal attempts of an idle worker before it parks, or yields
+        // if parking is off.
+        int spin_count;
+        // Park idle workers on a condition variable. Without it, they keep
+        // spinning, which lowers the latency, but burns the cores.
+        bool is_parking;
+    };
+
+    /**
+     * A worker per core less one, spin a while, then park.
+     */
+    ExecutorOptions default_executor_options();
+
+    /**
+     * Persistent pool of worker threads with work stealing.
+     *
+     * Each worker owns a deque of tasks. It pops the most recent task of its
+     * own deque and, when it's empty, steals the oldest task of another one.
+     * The solvers share one pool, see `get_shared`, instead of opening an
+     * OpenMP team of their own per call.
+     */
+    class Executor {
+    public:
+        Executor(const ExecutorOptions &options);
+
+        Executor() = delete;
+        Executor(const Executor &) = delete;
+        Executor &operator=(const Executor &) = delete;
+
+        /**
+         * Run `task(i)` for each i in [0, num_tasks) and wait for them.
+         *
+         * The calling thread runs tasks too while it waits, so callers from
+         * several threads, or from a task, add to the workers instead of
+         * oversubscribing the cores. The tasks must not block on each other,
+         * they are not guaranteed to run concurrently.
+         */
+        void parallel_for(size_t num_tasks,
+                          const function<void(size_t)> &task);
+
+        /**
+         * Number of threads which can run tasks at once, with the caller.
+         */
+        int get_concurrency() const { return this->_workers.size() + 1; }
+
+        /**
+         * Whether the current thread is running a task of any executor.
+         */
+        static bool is_in_task();
+
+        /**
+         * The executor shared by the solvers, started on the first use.
+         */
+        static Executor &get_shared();
+
+        /**
+         * Set the options of the shared executor.
+         *
+         * @return False if the shared executor has already been started.
+         */
+        static bool configure_shared(const ExecutorOptions &options);
+
+        /**
+         * The options the shared executor is, or will be, started with.
+         */
+        static ExecutorOptions get_shared_options();
+
+        ~Executor();
+
+    private:
+        struct Job {
+            const function<void(size_t)> *task;
+            size_t idx;
+            atomic<size_t> *num_pending;
+        };
+
+        // Padded by a cache line on both sides, so the workers' locks don't
+        // false share. Not `alignas(64)`, plain `new` ignores it in C++14.
+        struct WorkerQueue {
+            char front_padding[64];
+            mutex lock;
+            deque<Job> jobs;
+            char back_padding[64];
+        };
+
+        void run_worker(size_t worker_idx);
+        bool pop_job(size_t queue_idx, Job &job);
+        bool steal_job(size_t thief_idx, Job &job);
+        void run_job(const Job &job);
+        void wake_workers(size_t num_jobs);
+
+        const ExecutorOptions _options;
+        // One more queue than workers, for the jobs of outside callers.
+        vector<unique_ptr<WorkerQueue>> _queues;
+        vector<thread> _workers;
+
+        atomic<size_t> _num_queued;
+        atomic<int> _num_parked;
+        atomic<bool> _is_stopping;
+        mutex _park_lock;
+        condition_variable _wake_up;
+    };
+}
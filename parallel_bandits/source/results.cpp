@@ -0,0 +1,227 @@
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "results.hpp"
+#include "utils.hpp"
+
+using namespace std;
+using namespace bandits;
+
+static const char MAGIC[] = "PBRESULT";
+static const uint32_t VERSION = 1;
+static const uint32_t SYNC_MARKER = 0x52534250; // "PBSR"
+
+// Column type codes stored in the schema header.
+enum ColumnType : uint8_t { UINT64 = 1, FLOAT64, UINT32, INT64, UINT8 };
+
+static const vector<pair<string, ColumnType>> COLUMNS = {
+    make_pair("num_arms", UINT64),
+    make_pair("min_gap", FLOAT64),
+    make_pair("num_threads", UINT32),
+    make_pair("epsilon", FLOAT64),
+    make_pair("delta", FLOAT64),
+    make_pair("elapsed", INT64),
+    make_pair("pulls", UINT64),
+    make_pair("solved", UINT8)
+};
+
+static const uint32_t PAYLOAD_SIZE = 8 + 8 + 4 + 8 + 8 + 8 + 8 + 1;
+
+static string make_header()
+{
+    string header(MAGIC, sizeof(MAGIC) - 1);
+    header.append(reinterpret_cast<const char *>(&VERSION), sizeof(VERSION));
+
+    uint32_t num_columns = COLUMNS.size();
+    header.append(reinterpret_cast<const char *>(&num_columns),
+                  sizeof(num_columns));
+    for (auto &column : COLUMNS) {
+        header.push_back(static_cast<char>(column.second));
+        header.push_back(static_cast<char>(column.first.size()));
+        header.append(column.first);
+    }
+
+    return header;
+}
+
+template <typename T>
+static void pack(char *&out, const T &value)
+{
+    memcpy(out, &value, sizeof(T));
+    out += sizeof(T);
+}
+
+template <typename T>
+static void unpack(const char *&in, T &value)
+{
+    memcpy(&value, in, sizeof(T));
+    in += sizeof(T);
+}
+
+static vector<string> make_column_names()
+{
+    vector<string> names;
+    for (auto &column : COLUMNS) {
+        names.push_back(column.first);
+    }
+
+    return names;
+}
+
+const vector<string> &bandits::get_result_columns()
+{
+    static const vector<string> names = make_column_names();
+    return names;
+}
+
+ResultsWriter::ResultsWriter(const string &path, WriteMode mode,
+                             size_t capacity) :
+    _queue(capacity), _is_closing(false)
+{
+    // Validate the file's schema if there are results to append to.
+    bool is_empty = true;
+    if (mode == WriteMode::Append) {
+        ifstream existing(path, ios::binary | ios::ate);
+        is_empty = !existing.is_open() || existing.tellg() == 0;
+    }
+    if (!is_empty && !ResultsReader(path).is_valid()) {
+        throw runtime_error("Results file has a different schema: " + path);
+    }
+
+    this->_file.open(path, ios::binary | (is_empty ? ios::trunc : ios::app));
+    if (!this->_file.is_open()) {
+        throw runtime_error("Can't open results file: " + path);
+    }
+    if (is_empty) {
+        auto header = make_header();
+        this->_file.write(header.data(), header.size());
+        this->_file.flush();
+    }
+
+    this->_writer = thread(&ResultsWriter::run, this);
+}
+
+void ResultsWriter::write(const ResultRecord &record)
+{
+    while (!this->_queue.push(record)) {
+        this_thread::yield();
+    }
+}
+
+void ResultsWriter::close()
+{
+    if (this->_writer.joinable()) {
+        this->_is_closing.store(true, memory_order_release);
+        this->_writer.join();
+        this->_file.close();
+    }
+}
+
+ResultsWriter::~ResultsWriter()
+{
+    this->close();
+}
+
+void ResultsWriter::run()
+{
+    char frame[4 + 4 + PAYLOAD_SIZE + 4];
+    ResultRecord record;
+
+    while (true) {
+        // Check it first, the records queued before closing are popped below.
+        auto is_closing = this->_is_closing.load(memory_order_acquire);
+
+        size_t num_written = 0;
+        while (this->_queue.pop(record)) {
+            char *out = frame;
+            pack(out, SYNC_MARKER);
+            pack(out, PAYLOAD_SIZE);
+
+            auto payload = out;
+            pack(out, record.num_arms);
+            pack(out, record.min_gap);
+            pack(out, record.num_threads);
+            pack(out, record.epsilon);
+            pack(out, record.delta);
+            pack(out, record.elapsed);
+            pack(out, record.pulls);
+            pack(out, record.solved);
+            pack(out, fnv1a(payload, PAYLOAD_SIZE));
+
+            this->_file.write(frame, sizeof(frame));
+            num_written++;
+        }
+
+        if (num_written > 0) {
+            this->_file.flush();
+        } else if (is_closing) {
+            break;
+        } else {
+            this_thread::sleep_for(chrono::milliseconds(1));
+        }
+    }
+}
+
+ResultsReader::ResultsReader(const string &path) :
+    _file(path, ios::binary), _is_valid(false)
+{
+    if (!this->_file.is_open()) {
+        return;
+    }
+
+    auto header = make_header();
+    string file_header(header.size(), '\0');
+    this->_file.read(&file_header[0], file_header.size());
+    this->_is_valid = this->_file.good() && file_header == header;
+}
+
+bool ResultsReader::next(ResultRecord &record)
+{
+    if (!this->_is_valid) {
+        return false;
+    }
+
+    char frame[4 + PAYLOAD_SIZE + 4];
+    uint32_t marker, payload_size;
+
+    while (true) {
+        auto frame_begin = this->_file.tellg();
+        if (!this->_file.read(reinterpret_cast<char *>(&marker),
+                              sizeof(marker))) {
+            return false;
+        }
+
+        const char *in = frame;
+        bool is_intact = false;
+        if (marker == SYNC_MARKER && this->_file.read(frame, sizeof(frame))) {
+            uint32_t checksum;
+            unpack(in, payload_size);
+            memcpy(&checksum, in + PAYLOAD_SIZE, sizeof(checksum));
+            is_intact = (payload_size == PAYLOAD_SIZE &&
+                         checksum == fnv1a(in, PAYLOAD_SIZE));
+        }
+
+        if (!is_intact) {
+            // Torn or corrupted frame, look for the next marker.
+            this->_file.clear();
+            this->_file.seekg(frame_begin + streamoff(1));
+            continue;
+        }
+
+        unpack(in, record.num_arms);
+        unpack(in, record.min_gap);
+        unpack(in, record.num_threads);
+        unpack(in, record.epsilon);
+        unpack(in, record.delta);
+        unpack(in, record.elapsed);
+        unpack(in, record.pulls);
+        unpack(in, record.solved);
+        return true;
+    }
+}
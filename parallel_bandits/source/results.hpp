@@ -0,0 +1,181 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+namespace bandits
+{
+    /**
+     * One measurement of the sweep driver.
+     */
+    struct ResultRecord {
+        uint64_t num_arms;
+        double min_gap;
+        uint32_t num_threads;
+        double epsilon;
+        double delta;
+        int64_t elapsed; // In milliseconds.
+        uint64_t pulls;
+        uint8_t solved;
+    };
+
+    /**
+     * Lock-free, single-producer single-consumer ring buffer.
+     *
+     * @tparam T Type of the queued values.
+     */
+    template <typename T>
+    class SpscQueue {
+    public:
+        /**
+         * @param capacity Max. number of queued values, rounded up to the
+         *     power of two.
+         */
+        SpscQueue(size_t capacity) : _head(0), _tail(0)
+        {
+            size_t size = 1;
+            while (size < capacity) {
+                size <<= 1;
+            }
+            this->_buffer.resize(size);
+            this->_mask = size - 1;
+        }
+
+        SpscQueue() = delete;
+
+        /**
+         * Enqueue the value, called only by the producer.
+         *
+         * @return False if the queue is full.
+         */
+        bool push(const T &value)
+        {
+            auto tail = this->_tail.load(memory_order_relaxed);
+            if (tail - this->_head.load(memory_order_acquire) >
+                this->_mask) {
+                return false;
+            }
+
+            this->_buffer[tail & this->_mask] = value;
+            this->_tail.store(tail + 1, memory_order_release);
+            return true;
+        }
+
+        /**
+         * Dequeue the value, called only by the consumer.
+         *
+         * @return False if the queue is empty.
+         */
+        bool pop(T &value)
+        {
+            auto head = this->_head.load(memory_order_relaxed);
+            if (head == this->_tail.load(memory_order_acquire)) {
+                return false;
+            }
+
+            value = this->_buffer[head & this->_mask];
+            this->_head.store(head + 1, memory_order_release);
+            return true;
+        }
+
+    private:
+        vector<T> _buffer;
+        size_t _mask;
+        // Producer and consumer indexes live on separate cache lines.
+        alignas(64) atomic<size_t> _head;
+        alignas(64) atomic<size_t> _tail;
+    };
+
+    enum class WriteMode { Append, Truncate };
+
+    /**
+     * Append-only binary sink of the results, written by a background thread.
+     *
+     * The file starts with a schema header (magic, version and the columns'
+     * types and names). Each record is framed as:
+     *   [sync marker][payload size][payload][FNV-1a checksum of payload]
+     * so a record torn by a crash is detected and skipped by the reader.
+     */
+    class ResultsWriter {
+    public:
+        /**
+         * Open the file and start the writer thread.
+         *
+         * @param path Path to the results file.
+         * @param mode If the file already holds results, append new records
+         *     after them, or truncate it and start over.
+         * @param capacity Max. number of records waiting to be written.
+         */
+        ResultsWriter(const string &path,
+                      WriteMode mode = WriteMode::Append,
+                      size_t capacity = 4096);
+
+        ResultsWriter() = delete;
+        ResultsWriter(const ResultsWriter &) = delete;
+        ResultsWriter &operator=(const ResultsWriter &) = delete;
+
+        /**
+         * Hand the record over to the writer thread.
+         *
+         * It doesn't touch the file. It only spins if the queue is full.
+         */
+        void write(const ResultRecord &record);
+
+        /**
+         * Write all the queued records and stop the writer thread.
+         */
+        void close();
+
+        ~ResultsWriter();
+
+    private:
+        void run();
+
+        ofstream _file;
+        SpscQueue<ResultRecord> _queue;
+        atomic<bool> _is_closing;
+        thread _writer;
+    };
+
+    /**
+     * Reader of the results files written by ResultsWriter.
+     */
+    class ResultsReader {
+    public:
+        /**
+         * Open the file and validate its schema header.
+         *
+         * @param path Path to the results file.
+         */
+        ResultsReader(const string &path);
+
+        ResultsReader() = delete;
+
+        /**
+         * @return False if the file is missing or its schema doesn't match.
+         */
+        bool is_valid() const { return this->_is_valid; };
+
+        /**
+         * Read the next intact record, skipping the torn ones.
+         *
+         * @param[out] record The read record.
+         * @return False if there are no more records.
+         */
+        bool next(ResultRecord &record);
+
+    private:
+        ifstream _file;
+        bool _is_valid;
+    };
+
+    /**
+     * Column names of the results, in the order of the CSV layout.
+     */
+    const vector<string> &get_result_columns();
+}
@@ -0,0 +1,291 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <numeric>
+#include <omp.h>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "algorithms.hpp"
+#include "bandits.hpp"
+#include "executor.hpp"
+#include "tuner.hpp"
+
+using namespace std;
+using namespace bandits;
+using namespace chrono;
+
+static double seconds_since(steady_clock::time_point begin)
+{
+    return duration<double>(steady_clock::now() - begin).count();
+}
+
+static double measure_dispatch_time(Executor &executor, int num_tasks,
+                                    int num_dispatches)
+{
+    auto begin = steady_clock::now();
+    for (int i = 0; i < num_dispatches; i++) {
+        executor.parallel_for(num_tasks, [](size_t) { });
+    }
+
+    return seconds_since(begin) / num_dispatches;
+}
+
+HostProfile bandits::profile_host()
+{
+    const size_t num_pulls = 1 << 20;
+    const int num_dispatches = 100;
+    HostProfile profile;
+    profile.num_cores = omp_get_num_procs();
+
+    // A pool like the shared one, but the shared one can still be configured.
+    Executor executor(Executor::get_shared_options());
+
+    // Pull rate of one core, then of all cores together.
+    BernoulliArm arm(0.5);
+    double total_return = 0;
+    auto begin = steady_clock::now();
+    for (size_t i = 0; i < num_pulls; i++) {
+        total_return += arm.pull();
+    }
+    profile.pull_rate = num_pulls / seconds_since(begin);
+
+    vector<double> tasks_returns(profile.num_cores, 0);
+    begin = steady_clock::now();
+    executor.parallel_for(profile.num_cores, [&](size_t task_idx) {
+        double task_return = 0;
+        for (size_t i = 0; i < num_pulls; i++) {
+            task_return += arm.pull();
+        }
+        tasks_returns[task_idx] = task_return;
+    });
+    total_return += accumulate(tasks_returns.begin(), tasks_returns.end(), 0.0);
+    auto parallel_rate = profile.num_cores * num_pulls / seconds_since(begin);
+    profile.parallel_efficiency =
+        min(1.0, parallel_rate / (profile.num_cores * profile.pull_rate));
+
+    // Fit `dispatch + task * num_tasks` from two numbers of tasks.
+    measure_dispatch_time(executor, profile.num_cores,
+                          num_dispatches); // Warm up.
+    auto few_tasks_time = measure_dispatch_time(executor, profile.num_cores,
+                                                num_dispatches);
+    auto many_tasks_time = measure_dispatch_time(
+        executor, 2 * profile.num_cores, num_dispatches);
+    profile.task_overhead =
+        max(0.0, (many_tasks_time - few_tasks_time) / profile.num_cores);
+    profile.dispatch_overhead =
+        max(0.0, few_tasks_time - profile.task_overhead * profile.num_cores);
+
+    // Streaming read of a buffer larger than the caches.
+    vector<double> buffer(1 << 23, 1.0);
+    double total = 0;
+    begin = steady_clock::now();
+    for (int i = 0; i < 3; i++) {
+        for (auto &value : buffer) {
+            total += value;
+        }
+    }
+    profile.memory_bandwidth =
+        3 * buffer.size() * sizeof(double) / seconds_since(begin);
+
+    // Keep the measured loops from being optimized away.
+    if (total_return < 0 || total < 0) {
+        profile.pull_rate = 0;
+    }
+
+    return profile;
+}
+
+bool bandits::save_host_profile(const HostProfile &profile,
+                                const string &path)
+{
+    ofstream file(path, fstream::out);
+    file.precision(17);
+    file << "num_cores " << profile.num_cores << "\n"
+         << "pull_rate " << profile.pull_rate << "\n"
+         << "parallel_efficiency " << profile.parallel_efficiency << "\n"
+         << "dispatch_overhead " << profile.dispatch_overhead << "\n"
+         << "task_overhead " << profile.task_overhead << "\n"
+         << "memory_bandwidth " << profile.memory_bandwidth << "\n";
+
+    return file.good();
+}
+
+bool bandits::load_host_profile(const string &path, HostProfile &profile)
+{
+    ifstream file(path);
+    map<string, double> values;
+    string key;
+    double value;
+    while (file >> key >> value) {
+        values[key] = value;
+    }
+
+    const vector<string> keys = {
+        "num_cores", "pull_rate", "parallel_efficiency",
+        "dispatch_overhead", "task_overhead", "memory_bandwidth"
+    };
+    for (auto &key : keys) {
+        if (values.count(key) == 0) {
+            return false;
+        }
+    }
+
+    profile.num_cores = static_cast<int>(values["num_cores"]);
+    profile.pull_rate = values["pull_rate"];
+    profile.parallel_efficiency = values["parallel_efficiency"];
+    profile.dispatch_overhead = values["dispatch_overhead"];
+    profile.task_overhead = values["task_overhead"];
+    profile.memory_bandwidth = values["memory_bandwidth"];
+    return true;
+}
+
+HostProfile bandits::load_or_profile_host(const string &path)
+{
+    HostProfile profile;
+    if (load_host_profile(path, profile) &&
+        profile.num_cores == omp_get_num_procs()) {
+        return profile;
+    }
+
+    profile = profile_host();
+    save_host_profile(profile, path);
+    return profile;
+}
+
+/**
+ * Worst-case pulls of `MedianElimination::solve`.
+ */
+static double median_elimination_pulls(size_t num_arms, double epsilon,
+                                       double delta)
+{
+    double pulls = 0;
+    epsilon = epsilon / 4;
+    delta = delta / 2;
+    while (num_arms > 1) {
+        pulls += num_arms * ceil(1 / pow(epsilon / 2, 2) * log(3 / delta));
+        num_arms = (num_arms + 1) / 2;
+        epsilon = 0.75 * epsilon;
+        delta = delta / 2.0;
+    }
+
+    return pulls;
+}
+
+TunedConfig
+Tuner::predict(SolverKind solver, int num_players, size_t num_arms,
+               double epsilon, double delta) const
+{
+    if (!(epsilon > 0)) {
+        // The round schedules are infinite without a positive ε.
+        throw invalid_argument("Tuner needs a positive epsilon");
+    }
+
+    auto &profile = this->_profile;
+    TunedConfig config = {solver, num_players, 0, 0};
+
+    if (solver == SolverKind::ExpGap) {
+        // Mirrors `ExpGapElimination::solve`, as if no arm was eliminated.
+        config.num_players = 1;
+        for (int round = 1; round < ceil(log2(1 / epsilon)); round++) {
+            double epsilon_r = pow(2, -round) / 4;
+            double delta_r = delta / (50.0 * pow(round, 3));
+            config.predicted_pulls +=
+                num_arms * ceil(2 / pow(epsilon_r, 2) * log(2 / delta_r)) +
+                median_elimination_pulls(num_arms, epsilon_r / 2, delta_r);
+        }
+        config.predicted_time = config.predicted_pulls / profile.pull_rate;
+        return config;
+    }
+
+    // Mirrors `MultiRoundEpsilonArm::solve`, as if no arm was eliminated.
+    int num_rounds = ceil(log2(2 / epsilon));
+    double time = (2 / (num_players * pow(pow(2, -num_rounds), 2))) *
+        log((4 * num_arms * pow(num_rounds, 2)) / delta);
+    config.predicted_pulls = num_players * num_arms * ceil(time);
+
+    // Pull rate degrades linearly up to all cores being busy.
+    auto num_busy = min(num_players, profile.num_cores);
+    auto efficiency = 1 - (1 - profile.parallel_efficiency) *
+        (num_busy - 1) / max(profile.num_cores - 1, 1);
+    auto pull_rate = profile.pull_rate * num_busy * efficiency;
+
+    auto dispatch_time = profile.dispatch_overhead +
+        profile.task_overhead * num_players;
+    auto table_bytes = (double) num_players * num_arms * sizeof(double);
+
+    config.predicted_time = config.predicted_pulls / pull_rate;
+    if (solver == SolverKind::MultiRound) {
+        // A dispatch to the shared executor and the averaging each round.
+        config.predicted_time += num_rounds *
+            (dispatch_time + table_bytes / profile.memory_bandwidth);
+    } else {
+        // One dispatch, but every player reads the pooled slots (three
+        // times the size of a double) of all survivors each round.
+        config.predicted_time += dispatch_time +
+            num_rounds * 3 * table_bytes / profile.memory_bandwidth;
+    }
+
+    return config;
+}
+
+TunedConfig
+Tuner::select(size_t num_arms, double epsilon, double delta,
+              size_t budget) const
+{
+    vector<TunedConfig> configs;
+    configs.push_back(predict(SolverKind::ExpGap, 1, num_arms,
+                              epsilon, delta));
+    for (int num_players = 1; num_players <= 2 * this->_profile.num_cores;
+         num_players *= 2) {
+        configs.push_back(predict(SolverKind::MultiRound, num_players,
+                                  num_arms, epsilon, delta));
+        configs.push_back(predict(SolverKind::AsyncMultiRound, num_players,
+                                  num_arms, epsilon, delta));
+    }
+
+    // The fastest within the budget, or the one with the least pulls.
+    const TunedConfig *best_config = nullptr;
+    for (auto &config : configs) {
+        if (config.predicted_pulls <= budget &&
+            (best_config == nullptr ||
+             config.predicted_time < best_config->predicted_time)) {
+            best_config = &config;
+        }
+    }
+    if (best_config == nullptr) {
+        for (auto &config : configs) {
+            if (best_config == nullptr ||
+                config.predicted_pulls < best_config->predicted_pulls) {
+                best_config = &config;
+            }
+        }
+    }
+
+    return *best_config;
+}
+
+unique_ptr<IAlgorithm>
+Tuner::make_algorithm(size_t num_arms, double epsilon, double delta,
+                      size_t budget) const
+{
+    auto config = this->select(num_arms, epsilon, delta, budget);
+    switch (config.solver) {
+    case SolverKind::ExpGap:
+        return unique_ptr<IAlgorithm>(
+            new ExpGapElimination(epsilon, delta, budget));
+    case SolverKind::MultiRound:
+        return unique_ptr<IAlgorithm>(
+            new MultiRoundEpsilonArm(config.num_players, epsilon, delta,
+                                     budget));
+    case SolverKind::AsyncMultiRound:
+    default:
+        return unique_ptr<IAlgorithm>(
+            new AsyncMultiRoundEpsilonArm(config.num_players, epsilon, delta,
+                                          budget));
+    }
+}
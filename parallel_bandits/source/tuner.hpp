@@ -0,0 +1,125 @@
+#pragma once
+#include <memory>
+#include <string>
+
+#include "algorithms.hpp"
+
+using namespace std;
+
+namespace bandits
+{
+    /**
+     * Micro-profiled costs of the host the solvers run on.
+     */
+    struct HostProfile {
+        int num_cores;
+        // Arm pulls per second on one core.
+        double pull_rate;
+        // Aggregate pull rate of all cores over `num_cores * pull_rate`.
+        double parallel_efficiency;
+        // Seconds of a `parallel_for` of the shared executor, plus per task.
+        double dispatch_overhead;
+        double task_overhead;
+        // Bytes per second of a streaming read.
+        double memory_bandwidth;
+    };
+
+    /**
+     * Measure the host costs, it takes a fraction of a second.
+     *
+     * The executor costs are measured on a private pool with the shared
+     * executor's options, so the shared one can still be configured.
+     */
+    HostProfile profile_host();
+
+    /**
+     * Save the profile as a text file.
+     *
+     * @return False if the file can't be written.
+     */
+    bool save_host_profile(const HostProfile &profile, const string &path);
+
+    /**
+     * Load the profile saved with `save_host_profile`.
+     *
+     * @param[in] path Path to the profile file.
+     * @param[out] profile The loaded profile.
+     * @return False if the file is missing or incomplete.
+     */
+    bool load_host_profile(const string &path, HostProfile &profile);
+
+    /**
+     * Load the cached profile or, if it's missing or was measured on a host
+     * with another number of cores, profile the host and cache it.
+     *
+     * @param path Path to the profile cache file.
+     */
+    HostProfile load_or_profile_host(const string &path);
+
+    enum class SolverKind { ExpGap, MultiRound, AsyncMultiRound };
+
+    struct TunedConfig {
+        SolverKind solver;
+        int num_players;
+        // Worst-case (no early elimination) predictions.
+        double predicted_pulls;
+        double predicted_time; // In seconds.
+    };
+
+    class Tuner
+    {
+    public:
+        /**
+         * Initialize the solver auto-tuner.
+         *
+         * It predicts the running time of each solver and number of players
+         * from the host profile and the solvers' round schedules, instead of
+         * running a sweep.
+         *
+         * @param profile The host costs, see `load_or_profile_host`.
+         */
+        Tuner(const HostProfile &profile) : _profile(profile) { }
+
+        Tuner() = delete;
+
+        /**
+         * Predict the cost of the solver configuration.
+         *
+         * @param solver Solver to run.
+         * @param num_players Number of players, ignored by ExpGap.
+         * @param num_arms Number of bandit arms.
+         * @param epsilon Find an arm that is at most ε worse than the optimal,
+         *     it has to be positive.
+         * @param delta With probability of at least 1-δ find an ε-optimal arm.
+         * @throw invalid_argument If ε isn't positive, as in `select` and
+         *     `make_algorithm`.
+         */
+        TunedConfig
+        predict(SolverKind solver, int num_players, size_t num_arms,
+                double epsilon, double delta) const;
+
+        /**
+         * Select the fastest solver configuration.
+         *
+         * @param num_arms Number of bandit arms.
+         * @param epsilon Find an arm that is at most ε worse than the optimal,
+         *     it has to be positive.
+         * @param delta With probability of at least 1-δ find an ε-optimal arm.
+         * @param budget Limit of arm pulls. Configurations predicted to
+         *     exceed it are skipped, unless all of them do.
+         */
+        TunedConfig
+        select(size_t num_arms, double epsilon, double delta,
+               size_t budget) const;
+
+        /**
+         * Make the fastest solver, see `select`.
+         */
+        unique_ptr<IAlgorithm>
+        make_algorithm(size_t num_arms, double epsilon, double delta,
+                       size_t budget) const;
+
+    private:
+        const HostProfile _profile;
+    };
+}
@@ -41,3 +41,26 @@ void MedianHeap::push(value_type value)
         this->min_heap.pop_back();
     }
 }
+
+void bandits::select_top(vector<MedianHeap::value_type> &values, size_t count)
+{
+    if (count == 0 || count >= values.size()) {
+        return;
+    }
+
+    nth_element(values.begin(),
+                values.begin() + (count - 1),
+                values.end(),
+                greater<MedianHeap::value_type>());
+}
+
+uint32_t bandits::fnv1a(const char *data, size_t size)
+{
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= static_cast<uint8_t>(data[i]);
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
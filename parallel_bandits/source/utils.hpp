@@ -1,4 +1,7 @@
 #pragma once
+#include <cstddef>
+#include <cstdint>
+#include <utility>
 #include <vector>
 
 using namespace std;
@@ -16,4 +19,20 @@ namespace bandits
         vector<value_type> max_heap;
         vector<value_type> min_heap;
     };
+
+    /**
+     * Partially reorder the values so the `count` highest come first.
+     *
+     * The first `count` values are in no particular order. It runs in linear
+     * time, so prefer it over a full sort when only the top values matter.
+     *
+     * @param[in, out] values Pairs of (empirical value, arm index).
+     * @param count Number of the highest values to move to the front.
+     */
+    void select_top(vector<MedianHeap::value_type> &values, size_t count);
+
+    /**
+     * FNV-1a hash of the bytes, to checksum the files we write.
+     */
+    uint32_t fnv1a(const char *data, size_t size);
 };
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <vector>
 
 #include "algorithms.hpp"
@@ -64,3 +65,203 @@ TEST_F(MABAlgorithmTest, GIVENMultiRoundEpsArmWHENSolveMABTHENReturnBestArm) {
     // Test
     EXPECT_EQ(arm, 1);
 }
+
+TEST_F(MABAlgorithmTest, GIVENMedianEliminationWHENSolveTopKTHENReturnTopArms) {
+    // Set Up
+    MedianElimination algo(0.1, 0.01, (size_t) -1);
+
+    // Run
+    auto arms = algo.solve_topk(bandit, 2);
+    sort(arms.begin(), arms.end());
+
+    // Test
+    EXPECT_EQ(arms, vector<size_t>({0, 1}));
+}
+
+TEST_F(MABAlgorithmTest, GIVENExpGapEliminationWHENSolveTopKTHENReturnTopArms) {
+    // Set Up
+    ExpGapElimination algo(0.1, 0.01, (size_t) -1);
+
+    // Run
+    auto arms = algo.solve_topk(bandit, 2);
+    sort(arms.begin(), arms.end());
+
+    // Test
+    EXPECT_EQ(arms, vector<size_t>({0, 1}));
+}
+
+TEST_F(MABAlgorithmTest, GIVENOneRoundBestArmWHENSolveTopKTHENReturnTopArms) {
+    // Set Up
+    auto num_agents = 5;
+    auto limit_pulls = 8000000;
+    OneRoundBestArm algo(num_agents, limit_pulls);
+
+    // Run
+    auto arms = algo.solve_topk(bandit, 2);
+    sort(arms.begin(), arms.end());
+
+    // Test
+    EXPECT_EQ(arms, vector<size_t>({0, 1}));
+}
+
+TEST_F(MABAlgorithmTest, GIVENMultiRoundEpsArmWHENSolveTopKTHENReturnTopArms) {
+    // Set Up
+    auto num_agents = 5;
+    MultiRoundEpsilonArm algo(num_agents, 0.1, 0.01, (size_t) -1);
+
+    // Run
+    auto arms = algo.solve_topk(bandit, 2);
+    sort(arms.begin(), arms.end());
+
+    // Test
+    EXPECT_EQ(arms, vector<size_t>({0, 1}));
+}
+
+TEST_F(MABAlgorithmTest, GIVENKAboveNumArmsWHENSolveTopKTHENReturnAllArms) {
+    // Set Up
+    MedianElimination algo(0.1, 0.01, (size_t) -1);
+
+    // Run
+    auto arms = algo.solve_topk(bandit, bandit.size() + 1);
+    sort(arms.begin(), arms.end());
+
+    // Test
+    EXPECT_EQ(arms, vector<size_t>({0, 1, 2, 3, 4, 5, 6}));
+}
+
+TEST(MABAlgorithm, GIVENEmptyBanditWHENOneRoundSolveTopKTHENNoArms) {
+    // Set Up
+    vector<shared_ptr<IBanditArm>> bandit;
+    OneRoundBestArm algo(4, 10000);
+
+    // Run
+    auto arms = algo.solve_topk(bandit, 2);
+
+    // Test
+    EXPECT_TRUE(arms.empty());
+}
+
+TEST(MABAlgorithm, GIVENPullLimitWHENExpGapSolveTopKTHENBestLookingArms) {
+    // Set Up
+    auto bandit = make_bernoulli_bandit({0.1, 0.2, 0.9, 0.8});
+    // Halts in the nested elimination of the first round.
+    ExpGapElimination algo(0.01, 0.1, 10000);
+
+    // Run
+    auto arms = algo.solve_topk(bandit, 2);
+
+    // Test
+    EXPECT_EQ(arms, vector<size_t>({2, 3}));
+}
+
+TEST_F(MABAlgorithmTest, GIVENAsyncMultiRoundWHENSolveMABTHENReturnBestArm) {
+    // Set Up
+    auto num_agents = 5;
+    AsyncMultiRoundEpsilonArm algo(num_agents, 0.1, 0.01, (size_t) -1);
+
+    // Run
+    auto arm = algo.solve(bandit);
+
+    // Test
+    EXPECT_EQ(arm, 1);
+}
+
+TEST_F(MABAlgorithmTest, GIVENAsyncMultiRoundWHENSolveTopKTHENReturnTopArms) {
+    // Set Up
+    auto num_agents = 5;
+    AsyncMultiRoundEpsilonArm algo(num_agents, 0.1, 0.01, (size_t) -1);
+
+    // Run
+    auto arms = algo.solve_topk(bandit, 2);
+    sort(arms.begin(), arms.end());
+
+    // Test
+    EXPECT_EQ(arms, vector<size_t>({0, 1}));
+}
+
+TEST_F(MABAlgorithmTest, GIVENExpGapBernsteinWHENSolveMABTHENReturnBestArm) {
+    // Set Up
+    ExpGapElimination algo(0.1, 0.01, (size_t) -1, Bound::EmpiricalBernstein);
+
+    // Run
+    auto arm = algo.solve(bandit);
+
+    // Test
+    EXPECT_EQ(arm, 1);
+}
+
+TEST_F(MABAlgorithmTest, GIVENMultiRoundBernsteinWHENSolveMABTHENReturnBestArm) {
+    // Set Up
+    auto num_agents = 5;
+    MultiRoundEpsilonArm algo(num_agents, 0.1, 0.01, (size_t) -1,
+                              Bound::EmpiricalBernstein);
+
+    // Run
+    auto arm = algo.solve(bandit);
+
+    // Test
+    EXPECT_EQ(arm, 1);
+}
+
+TEST(MABAlgorithm, GIVENLowVarianceArmsWHENBernsteinTHENFewerPulls) {
+    // Set Up
+    auto bandit = make_bernoulli_bandit({0.02, 0.02, 0.02, 0.02, 0.05});
+    MultiRoundEpsilonArm hoeffding_algo(2, 0.01, 0.05, (size_t) -1);
+    MultiRoundEpsilonArm bernstein_algo(2, 0.01, 0.05, (size_t) -1,
+                                        Bound::EmpiricalBernstein);
+    size_t hoeffding_pulls = 0, bernstein_pulls = 0;
+
+    // Run
+    auto hoeffding_arm = hoeffding_algo.solve(bandit, hoeffding_pulls);
+    auto bernstein_arm = bernstein_algo.solve(bandit, bernstein_pulls);
+
+    // Test
+    EXPECT_EQ(hoeffding_arm, 4);
+    EXPECT_EQ(bernstein_arm, 4);
+    EXPECT_LT(bernstein_pulls, hoeffding_pulls);
+}
+
+TEST(MABAlgorithm, GIVENLowVarianceArmsWHENExpGapBernsteinTHENFewerPulls) {
+    // Set Up
+    auto bandit = make_bernoulli_bandit({0.02, 0.02, 0.02, 0.02, 0.3});
+    ExpGapElimination hoeffding_algo(0.25, 0.05, (size_t) -1);
+    ExpGapElimination bernstein_algo(0.25, 0.05, (size_t) -1,
+                                     Bound::EmpiricalBernstein);
+    size_t hoeffding_pulls = 0, bernstein_pulls = 0;
+
+    // Run
+    auto hoeffding_arm = hoeffding_algo.solve(bandit, hoeffding_pulls);
+    auto bernstein_arm = bernstein_algo.solve(bandit, bernstein_pulls);
+
+    // Test
+    EXPECT_EQ(hoeffding_arm, 4);
+    EXPECT_EQ(bernstein_arm, 4);
+    EXPECT_LT(2 * bernstein_pulls, hoeffding_pulls);
+}
+
+TEST(MABAlgorithm, GIVENPullLimitWHENExpGapBernsteinTopKTHENBestLookingArms) {
+    // Set Up
+    auto bandit = make_bernoulli_bandit({0.01, 0.02, 0.99, 0.98});
+    // Enough for the first Hoeffding evaluation, but not its fallback.
+    ExpGapElimination algo(0.01, 0.1, 3700, Bound::EmpiricalBernstein);
+
+    // Run
+    auto arms = algo.solve_topk(bandit, 2);
+
+    // Test
+    EXPECT_EQ(arms, vector<size_t>({2, 3}));
+}
+
+TEST_F(MABAlgorithmTest, GIVENMultiRoundBernsteinWHENSolveTopKTHENTopArms) {
+    // Set Up
+    auto num_agents = 5;
+    MultiRoundEpsilonArm algo(num_agents, 0.1, 0.01, (size_t) -1,
+                              Bound::EmpiricalBernstein);
+
+    // Run
+    auto arms = algo.solve_topk(bandit, 2);
+    sort(arms.begin(), arms.end());
+
+    // Test
+    EXPECT_EQ(arms, vector<size_t>({0, 1}));
+}
@@ -0,0 +1,191 @@
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "algorithms.hpp"
+#include "bandits.hpp"
+#include "checkpoint.hpp"
+#include "gtest/gtest.h"
+
+using namespace std;
+using namespace bandits;
+
+class CheckpointTest: public ::testing::Test {
+public:
+    void SetUp() {
+        remove(path.c_str());
+        vector<double> expected_values =
+            {0.6, 0.7, 0.45, 0.45, 0.45, 0.45, 0.45};
+        this->bandit = make_bernoulli_bandit(expected_values);
+
+        this->state = {7, 2, 1, Bound::Hoeffding, 0.1, 0.01, 42, 3, 0.25,
+                       123.5, 1000, 0, {1, 4}, {{0.7, 0.4}, {0.65, 0.5}}};
+    }
+
+    void TearDown() {
+        remove(path.c_str());
+    }
+
+    const string path = "checkpoint_test.bin";
+    vector<shared_ptr<IBanditArm>> bandit;
+    MultiRoundState state;
+};
+
+TEST_F(CheckpointTest, GIVENSavedStateWHENLoadTHENSameState) {
+    // Set Up
+    MultiRoundState loaded_state;
+
+    // Run
+    auto is_saved = save_checkpoint(state, path);
+    auto is_loaded = load_checkpoint(path, loaded_state);
+
+    // Test
+    EXPECT_TRUE(is_saved);
+    EXPECT_TRUE(is_loaded);
+    EXPECT_EQ(loaded_state.num_arms, state.num_arms);
+    EXPECT_EQ(loaded_state.num_players, state.num_players);
+    EXPECT_EQ(loaded_state.num_top, state.num_top);
+    EXPECT_EQ(loaded_state.bound, state.bound);
+    EXPECT_EQ(loaded_state.target_epsilon, state.target_epsilon);
+    EXPECT_EQ(loaded_state.delta, state.delta);
+    EXPECT_EQ(loaded_state.seed, state.seed);
+    EXPECT_EQ(loaded_state.round, state.round);
+    EXPECT_EQ(loaded_state.epsilon, state.epsilon);
+    EXPECT_EQ(loaded_state.time, state.time);
+    EXPECT_EQ(loaded_state.pulls, state.pulls);
+    EXPECT_EQ(loaded_state.arm_pulls, state.arm_pulls);
+    EXPECT_EQ(loaded_state.current_idxs, state.current_idxs);
+    EXPECT_EQ(loaded_state.empirical_values, state.empirical_values);
+}
+
+TEST_F(CheckpointTest, GIVENBernsteinStateWHENLoadTHENSameSquares) {
+    // Set Up
+    state.bound = Bound::EmpiricalBernstein;
+    state.arm_pulls = 64;
+    state.empirical_squares = {{30.5, 12}, {28, 16.5}};
+    MultiRoundState loaded_state;
+
+    // Run
+    save_checkpoint(state, path);
+    auto is_loaded = load_checkpoint(path, loaded_state);
+
+    // Test
+    EXPECT_TRUE(is_loaded);
+    EXPECT_EQ(loaded_state.bound, state.bound);
+    EXPECT_EQ(loaded_state.arm_pulls, state.arm_pulls);
+    EXPECT_EQ(loaded_state.empirical_squares, state.empirical_squares);
+}
+
+TEST_F(CheckpointTest, GIVENCorruptedCheckpointWHENLoadTHENFail) {
+    // Set Up
+    MultiRoundState loaded_state;
+    save_checkpoint(state, path);
+    {
+        fstream file(path, ios::binary | ios::in | ios::out);
+        file.seekp(20);
+        file.put('X');
+    }
+
+    // Run & Test
+    EXPECT_FALSE(load_checkpoint(path, loaded_state));
+}
+
+TEST_F(CheckpointTest, GIVENArmIdxOutOfRangeWHENLoadTHENFail) {
+    // Set Up
+    MultiRoundState loaded_state;
+    state.current_idxs = {1, state.num_arms};
+    save_checkpoint(state, path);
+
+    // Run & Test
+    EXPECT_FALSE(load_checkpoint(path, loaded_state));
+}
+
+TEST_F(CheckpointTest, GIVENInterruptedSolveWHENResumeTHENSameResult) {
+    // Set Up
+    auto num_agents = 2;
+    MultiRoundEpsilonArm uninterrupted_algo(num_agents, 0.1, 0.01,
+                                            (size_t) -1, 42, "");
+    // Halts in the second round, after the first checkpoint.
+    MultiRoundEpsilonArm interrupted_algo(num_agents, 0.1, 0.01,
+                                          500, 42, path);
+    MultiRoundEpsilonArm resumed_algo(num_agents, 0.1, 0.01,
+                                      (size_t) -1, 42, path);
+    size_t uninterrupted_pulls = 0, interrupted_pulls = 0, resumed_pulls = 0;
+
+    // Run
+    auto uninterrupted_arm = uninterrupted_algo.solve(bandit,
+                                                      uninterrupted_pulls);
+    interrupted_algo.solve(bandit, interrupted_pulls);
+    auto is_checkpointed = ifstream(path).good();
+    auto resumed_arm = resumed_algo.solve(bandit, resumed_pulls);
+
+    // Test
+    EXPECT_TRUE(is_checkpointed);
+    EXPECT_EQ(resumed_arm, uninterrupted_arm);
+    EXPECT_EQ(resumed_pulls, uninterrupted_pulls);
+    EXPECT_FALSE(ifstream(path).good());
+}
+
+TEST_F(CheckpointTest, GIVENCheckpointWHENSolveTHENResumeFromIt) {
+    // Set Up
+    MultiRoundEpsilonArm algo(2, 0.1, 0.01, (size_t) -1, 42, path);
+    // Only the arm 4 is left, so there is nothing more to pull.
+    state.current_idxs = {4};
+    state.empirical_values = {{0.4}, {0.5}};
+    save_checkpoint(state, path);
+    size_t total_pulls = 0;
+
+    // Run
+    auto arm = algo.solve(bandit, total_pulls);
+
+    // Test
+    EXPECT_EQ(arm, 4);
+    EXPECT_EQ(total_pulls, state.pulls);
+}
+
+TEST_F(CheckpointTest, GIVENInterruptedSolveTopKWHENResumeTHENSameResult) {
+    // Set Up
+    MultiRoundEpsilonArm uninterrupted_algo(2, 0.1, 0.01, (size_t) -1,
+                                            42, "");
+    MultiRoundEpsilonArm interrupted_algo(2, 0.1, 0.01, 500, 42, path);
+    MultiRoundEpsilonArm resumed_algo(2, 0.1, 0.01, (size_t) -1, 42, path);
+    size_t uninterrupted_pulls = 0, interrupted_pulls = 0, resumed_pulls = 0;
+
+    // Run
+    auto uninterrupted_arms = uninterrupted_algo.solve_topk(
+        bandit, 2, uninterrupted_pulls);
+    interrupted_algo.solve_topk(bandit, 2, interrupted_pulls);
+    auto is_checkpointed = ifstream(path).good();
+    auto resumed_arms = resumed_algo.solve_topk(bandit, 2, resumed_pulls);
+
+    // Test
+    EXPECT_TRUE(is_checkpointed);
+    EXPECT_EQ(resumed_arms, uninterrupted_arms);
+    EXPECT_EQ(resumed_pulls, uninterrupted_pulls);
+}
+
+TEST_F(CheckpointTest, GIVENInterruptedBernsteinWHENResumeTHENSameResult) {
+    // Set Up
+    auto bound = Bound::EmpiricalBernstein;
+    MultiRoundEpsilonArm uninterrupted_algo(2, 0.1, 0.01, (size_t) -1,
+                                            42, "", bound);
+    MultiRoundEpsilonArm interrupted_algo(2, 0.1, 0.01, 500, 42, path,
+                                          bound);
+    MultiRoundEpsilonArm resumed_algo(2, 0.1, 0.01, (size_t) -1, 42, path,
+                                      bound);
+    size_t uninterrupted_pulls = 0, interrupted_pulls = 0, resumed_pulls = 0;
+
+    // Run
+    auto uninterrupted_arms = uninterrupted_algo.solve_topk(
+        bandit, 2, uninterrupted_pulls);
+    interrupted_algo.solve_topk(bandit, 2, interrupted_pulls);
+    auto is_checkpointed = ifstream(path).good();
+    auto resumed_arms = resumed_algo.solve_topk(bandit, 2, resumed_pulls);
+
+    // Test
+    EXPECT_TRUE(is_checkpointed);
+    EXPECT_EQ(resumed_arms, uninterrupted_arms);
+    EXPECT_EQ(resumed_pulls, uninterrupted_pulls);
+    EXPECT_FALSE(ifstream(path).good());
+}
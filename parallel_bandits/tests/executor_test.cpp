@@ -0,0 +1,103 @@
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "executor.hpp"
+#include "gtest/gtest.h"
+
+using namespace std;
+using namespace bandits;
+
+TEST(Executor, GIVENTasksWHENParallelForTHENEachRunOnce) {
+    // Set Up
+    Executor executor({3, 16, true});
+    vector<atomic<int>> run_counts(1000);
+    for (auto &count : run_counts) {
+        count = 0;
+    }
+
+    // Run
+    executor.parallel_for(run_counts.size(), [&](size_t i) {
+        run_counts[i]++;
+    });
+
+    // Test
+    for (auto &count : run_counts) {
+        EXPECT_EQ(count, 1);
+    }
+}
+
+TEST(Executor, GIVENNestedParallelForWHENParallelForTHENAllRun) {
+    // Set Up
+    Executor executor({2, 16, true});
+    atomic<int> num_runs(0);
+    atomic<bool> is_in_task(true);
+
+    // Run
+    executor.parallel_for(8, [&](size_t) {
+        executor.parallel_for(100, [&](size_t) {
+            num_runs++;
+            if (!Executor::is_in_task()) {
+                is_in_task = false;
+            }
+        });
+    });
+
+    // Test
+    EXPECT_EQ(num_runs, 800);
+    EXPECT_TRUE(is_in_task);
+    EXPECT_FALSE(Executor::is_in_task());
+}
+
+TEST(Executor, GIVENSeveralCallersWHENParallelForTHENAllRun) {
+    // Set Up
+    Executor executor({2, 16, false});
+    atomic<int> num_runs(0);
+    vector<thread> callers;
+
+    // Run
+    for (int i = 0; i < 4; i++) {
+        callers.emplace_back([&]() {
+            for (int j = 0; j < 50; j++) {
+                executor.parallel_for(10, [&](size_t) { num_runs++; });
+            }
+        });
+    }
+    for (auto &caller : callers) {
+        caller.join();
+    }
+
+    // Test
+    EXPECT_EQ(num_runs, 4 * 50 * 10);
+}
+
+TEST(Executor, GIVENNoWorkersWHENParallelForTHENCallerRunsAll) {
+    // Set Up
+    Executor executor({0, 16, true});
+    auto caller_id = this_thread::get_id();
+    int num_runs = 0;
+    bool is_caller = true;
+
+    // Run
+    executor.parallel_for(10, [&](size_t) {
+        num_runs++;
+        is_caller = is_caller && this_thread::get_id() == caller_id;
+    });
+
+    // Test
+    EXPECT_EQ(executor.get_concurrency(), 1);
+    EXPECT_EQ(num_runs, 10);
+    EXPECT_TRUE(is_caller);
+}
+
+TEST(Executor, GIVENStartedSharedExecutorWHENConfigureTHENFalse) {
+    // Set Up
+    Executor::get_shared();
+
+    // Run
+    auto is_configured = Executor::configure_shared(
+        default_executor_options());
+
+    // Test
+    EXPECT_FALSE(is_configured);
+}
@@ -0,0 +1,122 @@
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "results.hpp"
+#include "gtest/gtest.h"
+
+using namespace std;
+using namespace bandits;
+
+class ResultsTest: public ::testing::Test {
+public:
+    void SetUp() {
+        remove(path.c_str());
+        for (uint64_t i = 0; i < 100; i++) {
+            ResultRecord record = {i, 0.1, 8, 0.01, 0.05, 42, 1000 + i, 1};
+            this->records.push_back(record);
+        }
+    }
+
+    void TearDown() {
+        remove(path.c_str());
+    }
+
+    vector<ResultRecord> read_all() {
+        vector<ResultRecord> read_records;
+        ResultsReader reader(path);
+        ResultRecord record;
+        while (reader.next(record)) {
+            read_records.push_back(record);
+        }
+        return read_records;
+    }
+
+    const string path = "results_test.bin";
+    vector<ResultRecord> records;
+};
+
+TEST_F(ResultsTest, GIVENWrittenRecordsWHENReadTHENSameRecordsInOrder) {
+    // Set Up
+    ResultsWriter writer(path, WriteMode::Append, 8);
+
+    // Run
+    for (auto &record : records) {
+        writer.write(record);
+    }
+    writer.close();
+    auto read_records = read_all();
+
+    // Test
+    ASSERT_EQ(read_records.size(), records.size());
+    for (size_t i = 0; i < records.size(); i++) {
+        EXPECT_EQ(read_records[i].num_arms, records[i].num_arms);
+        EXPECT_EQ(read_records[i].min_gap, records[i].min_gap);
+        EXPECT_EQ(read_records[i].num_threads, records[i].num_threads);
+        EXPECT_EQ(read_records[i].epsilon, records[i].epsilon);
+        EXPECT_EQ(read_records[i].delta, records[i].delta);
+        EXPECT_EQ(read_records[i].elapsed, records[i].elapsed);
+        EXPECT_EQ(read_records[i].pulls, records[i].pulls);
+        EXPECT_EQ(read_records[i].solved, records[i].solved);
+    }
+}
+
+TEST_F(ResultsTest, GIVENTornRecordWHENAppendedTHENTornRecordSkipped) {
+    // Set Up
+    {
+        ResultsWriter writer(path);
+        writer.write(records[0]);
+        writer.write(records[1]);
+    }
+    {
+        // Simulate a crash in the middle of writing a record.
+        ofstream file(path, ios::binary | ios::app);
+        file.write("\x50\x42\x53\x52\x35\x00\x00\x00garbage", 15);
+    }
+
+    // Run
+    {
+        ResultsWriter writer(path);
+        writer.write(records[2]);
+    }
+    auto read_records = read_all();
+
+    // Test
+    ASSERT_EQ(read_records.size(), 3);
+    EXPECT_EQ(read_records[0].pulls, records[0].pulls);
+    EXPECT_EQ(read_records[1].pulls, records[1].pulls);
+    EXPECT_EQ(read_records[2].pulls, records[2].pulls);
+}
+
+TEST_F(ResultsTest, GIVENOtherFileWHENOpenWriterTHENThrow) {
+    // Set Up
+    {
+        ofstream file(path);
+        file << "num_arms,min_gap,num_threads,epsilon,delta\n";
+    }
+
+    // Run & Test
+    EXPECT_THROW(ResultsWriter writer(path), runtime_error);
+}
+
+TEST_F(ResultsTest, GIVENTruncateModeWHENOpenWriterTHENOldRecordsDropped) {
+    // Set Up
+    {
+        ResultsWriter writer(path);
+        writer.write(records[0]);
+        writer.write(records[1]);
+    }
+
+    // Run
+    {
+        ResultsWriter writer(path, WriteMode::Truncate);
+        writer.write(records[2]);
+    }
+    auto read_records = read_all();
+
+    // Test
+    ASSERT_EQ(read_records.size(), 1);
+    EXPECT_EQ(read_records[0].pulls, records[2].pulls);
+}
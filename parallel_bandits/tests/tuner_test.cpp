@@ -0,0 +1,112 @@
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+
+#include "tuner.hpp"
+#include "gtest/gtest.h"
+
+using namespace std;
+using namespace bandits;
+
+class TunerTest: public ::testing::Test {
+public:
+    void SetUp() {
+        // Cheap pulls, but costly threads.
+        this->profile.num_cores = 8;
+        this->profile.pull_rate = 1e8;
+        this->profile.parallel_efficiency = 0.5;
+        this->profile.dispatch_overhead = 1e-5;
+        this->profile.task_overhead = 3e-4;
+        this->profile.memory_bandwidth = 1e10;
+    }
+
+    HostProfile profile;
+};
+
+TEST_F(TunerTest, GIVENSavedProfileWHENLoadTHENSameProfile) {
+    // Set Up
+    const string path = "tuner_test_profile.txt";
+    HostProfile loaded_profile;
+
+    // Run
+    auto is_saved = save_host_profile(profile, path);
+    auto is_loaded = load_host_profile(path, loaded_profile);
+    remove(path.c_str());
+
+    // Test
+    EXPECT_TRUE(is_saved);
+    EXPECT_TRUE(is_loaded);
+    EXPECT_EQ(loaded_profile.num_cores, profile.num_cores);
+    EXPECT_EQ(loaded_profile.pull_rate, profile.pull_rate);
+    EXPECT_EQ(loaded_profile.parallel_efficiency,
+              profile.parallel_efficiency);
+    EXPECT_EQ(loaded_profile.dispatch_overhead, profile.dispatch_overhead);
+    EXPECT_EQ(loaded_profile.task_overhead, profile.task_overhead);
+    EXPECT_EQ(loaded_profile.memory_bandwidth, profile.memory_bandwidth);
+}
+
+TEST_F(TunerTest, GIVENMissingProfileWHENLoadTHENFail) {
+    // Set Up
+    HostProfile loaded_profile;
+
+    // Run & Test
+    EXPECT_FALSE(load_host_profile("missing_profile.txt", loaded_profile));
+}
+
+TEST_F(TunerTest, GIVENFewArmsWHENSelectTHENFewPlayers) {
+    // Set Up
+    Tuner tuner(profile);
+
+    // Run
+    auto few_arms = tuner.select(100, 0.2, 0.1, (size_t) -1);
+    auto many_arms = tuner.select(1000000, 0.01, 0.1, (size_t) -1);
+
+    // Test
+    EXPECT_LT(few_arms.num_players, many_arms.num_players);
+    EXPECT_GE(many_arms.num_players, profile.num_cores);
+    EXPECT_LT(few_arms.predicted_time, many_arms.predicted_time);
+}
+
+TEST_F(TunerTest, GIVENBudgetWHENSelectTHENWithinBudget) {
+    // Set Up
+    Tuner tuner(profile);
+    auto config = tuner.select(10000, 0.1, 0.1, (size_t) -1);
+
+    // Run
+    auto budget_config = tuner.select(10000, 0.1, 0.1,
+                                      config.predicted_pulls - 1);
+
+    // Test
+    EXPECT_LT(budget_config.predicted_pulls, config.predicted_pulls);
+}
+
+TEST_F(TunerTest, GIVENCostlyDispatchWHENPredictTHENPaidPerRoundBySync) {
+    // Set Up
+    auto costly_profile = profile;
+    costly_profile.dispatch_overhead += 1;
+    Tuner tuner(profile), costly_tuner(costly_profile);
+
+    // Run
+    auto sync = tuner.predict(SolverKind::MultiRound, 4, 1000, 0.1, 0.1);
+    auto costly_sync = costly_tuner.predict(SolverKind::MultiRound, 4,
+                                            1000, 0.1, 0.1);
+    auto async = tuner.predict(SolverKind::AsyncMultiRound, 4, 1000,
+                               0.1, 0.1);
+    auto costly_async = costly_tuner.predict(SolverKind::AsyncMultiRound, 4,
+                                             1000, 0.1, 0.1);
+
+    // Test
+    EXPECT_NEAR(costly_async.predicted_time - async.predicted_time, 1,
+                1e-6);
+    EXPECT_GT(costly_sync.predicted_time - sync.predicted_time, 2);
+}
+
+TEST_F(TunerTest, GIVENZeroEpsilonWHENSelectTHENThrow) {
+    // Set Up
+    Tuner tuner(profile);
+
+    // Run & Test
+    EXPECT_THROW(tuner.select(100, 0, 0.1, (size_t) -1), invalid_argument);
+    EXPECT_THROW(tuner.make_algorithm(100, -0.1, 0.1, (size_t) -1),
+                 invalid_argument);
+}
@@ -90,3 +90,27 @@ TEST(MedianHeap, GIVENEmptyHeapWHENPushedDuplicatesTHENMedianInTopOfMinHeap) {
         EXPECT_GE(value.first, median.first);
     }
 }
+
+TEST(SelectTop, GIVENValuesWHENSelectTopTHENHighestValuesFirst) {
+    // Set Up
+    vector<MedianHeap::value_type> data = {
+        make_pair(17.0, 1),
+        make_pair(21.0, 2),
+        make_pair(6.0, 3),
+        make_pair(10.5, 4),
+        make_pair(5.0, 5),
+        make_pair(-11.0, 6),
+        make_pair(100.0, 7)
+    };
+
+    // Run
+    select_top(data, 3);
+
+    // Test
+    for (size_t i = 3; i < data.size(); i++) {
+        EXPECT_LT(data[i].first, 17.0);
+    }
+    for (size_t i = 0; i < 3; i++) {
+        EXPECT_GE(data[i].first, 17.0);
+    }
+}